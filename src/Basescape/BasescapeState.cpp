@@ -30,6 +30,7 @@
 #include "../Savegame/SavedGame.h"
 #include "../Savegame/Base.h"
 #include "../Savegame/BaseFacility.h"
+#include "../Savegame/Craft.h"
 #include "../Mod/RuleBaseFacility.h"
 #include "../Savegame/Region.h"
 #include "../Mod/RuleRegion.h"
@@ -594,6 +595,7 @@ void BasescapeState::miniRightClick(Action *)
 		if (bases[baseIndex] == _base)
 		{
 			std::swap(bases[baseIndex], bases[baseIndex - 1]);
+			Craft::invalidateActive();
 			init();
 		}
 	}
@@ -429,7 +429,7 @@ void CraftArmorState::lstSoldiersClick(Action *action)
 	}
 
 	Soldier *s = _base->getSoldiers()->at(_lstSoldiers->getSelectedRow());
-	if (!(s->getCraft() && s->getCraft()->getStatus() == "STR_OUT"))
+	if (!(s->getCraft() && s->getCraft()->getStatus() == CRAFT_OUT))
 	{
 		if (action->getDetails()->button.button == SDL_BUTTON_LEFT)
 		{
@@ -557,7 +557,7 @@ void CraftArmorState::btnDeequipAllArmorClick(Action *action)
 	int row = 0;
 	for (auto* soldier : *_base->getSoldiers())
 	{
-		if (!(soldier->getCraft() && soldier->getCraft()->getStatus() == "STR_OUT"))
+		if (!(soldier->getCraft() && soldier->getCraft()->getStatus() == CRAFT_OUT))
 		{
 			Armor *a = soldier->getRules()->getDefaultArmor();
 
@@ -127,7 +127,7 @@ void CraftsState::init()
 		ss << craft->getNumWeapons() << "/" << craft->getRules()->getWeapons();
 		ss2 << craft->getNumTotalSoldiers();
 		ss3 << craft->getNumTotalVehicles();
-		_lstCrafts->addRow(5, craft->getName(_game->getLanguage()).c_str(), tr(craft->getStatus()).c_str(), ss.str().c_str(), ss2.str().c_str(), ss3.str().c_str());
+		_lstCrafts->addRow(5, craft->getName(_game->getLanguage()).c_str(), tr(craft->getStatusString()).c_str(), ss.str().c_str(), ss2.str().c_str(), ss3.str().c_str());
 	}
 }
 
@@ -157,7 +157,7 @@ void CraftsState::lstCraftsClick(Action *action)
 
 	if (_game->isLeftClick(action))
 	{
-		if (crafts[row]->getStatus() != "STR_OUT")
+		if (crafts[row]->getStatus() != CRAFT_OUT)
 		{
 			_game->pushState(new CraftInfoState(_base, row));
 		}
@@ -168,6 +168,7 @@ void CraftsState::lstCraftsClick(Action *action)
 		{
 			// move craft up in the list
 			std::swap(crafts[row], crafts[row - 1]);
+			Craft::invalidateActive();
 
 			// warp mouse
 			if (row != _lstCrafts->getScroll() && _lstCrafts->getScroll() == 0)
@@ -692,6 +692,7 @@ void AIModule::setupAmbush()
 		const int COVER_BONUS = 25;
 		const int FAST_PASS_THRESHOLD = 80;
 		Position origin = _save->getTileEngine()->getSightOriginVoxel(_aggroTarget);
+		const auto reachableWithAttack = getReachableWithAttackLookup();
 
 		// we'll use node positions for this, as it gives map makers a good degree of control over how the units will use the environment.
 		for (const auto* node : *_save->getNodes())
@@ -703,7 +704,7 @@ void AIModule::setupAmbush()
 			Position pos = node->getPosition();
 			Tile *tile = _save->getTile(pos);
 			if (tile == 0 || Position::distance2d(pos, _unit->getPosition()) > 10 || pos.z != _unit->getPosition().z || tile->getDangerous() ||
-				std::find(_reachableWithAttack.begin(), _reachableWithAttack.end(), _save->getTileIndex(pos))  == _reachableWithAttack.end())
+				!reachableWithAttack[_save->getTileIndex(pos)])
 				continue; // just ignore unreachable tiles
 
 			if (_traceAI)
@@ -1811,6 +1812,20 @@ void AIModule::evaluateAIMode()
 	}
 }
 
+/**
+ * Gets a lookup of tiles that the unit can reach and still attack from.
+ * @return Flag for each tile index.
+ */
+std::vector<bool> AIModule::getReachableWithAttackLookup() const
+{
+	std::vector<bool> lookup(_save->getMapSizeXYZ(), false);
+	for (int index : _reachableWithAttack)
+	{
+		lookup[index] = true;
+	}
+	return lookup;
+}
+
 /**
  * Find a position where we can see our target, and move there.
  * check the 11x11 grid for a position nearby where we can potentially target him.
@@ -1822,33 +1837,37 @@ bool AIModule::findFirePoint()
 		return false;
 	std::vector<Position> randomTileSearch = _save->getTileSearch(); // copy!
 	RNG::shuffle(randomTileSearch);
-	Position target;
 	const int BASE_SYSTEMATIC_SUCCESS = 100;
 	const int FAST_PASS_THRESHOLD = 125;
 	bool waitIfOutsideWeaponRange = _unit->getGeoscapeSoldier() ? false : _unit->getUnitRules()->waitIfOutsideWeaponRange();
 	bool extendedFireModeChoiceEnabled = _save->getBattleGame()->getMod()->getAIExtendedFireModeChoice();
 	int bestScore = 0;
 	_attackAction.type = BA_RETHINK;
+
+	const auto reachableWithAttack = getReachableWithAttackLookup();
+	// the target side of the line of fire check is the same for all candidates
+	TileEngine::UnitTargetInfo targetInfo;
+	const bool hasTargetInfo = _save->getTileEngine()->getUnitTargetInfo(_aggroTarget->getTile(), _unit, nullptr, targetInfo);
+	std::vector<Position> trajectory;
+	Position target;
 	for (const auto& randomPosition : randomTileSearch)
 	{
 		Position pos = _unit->getPosition() + randomPosition;
 		Tile *tile = _save->getTile(pos);
-		if (tile == 0  ||
-			std::find(_reachableWithAttack.begin(), _reachableWithAttack.end(), _save->getTileIndex(pos))  == _reachableWithAttack.end())
+		if (tile == 0 || !reachableWithAttack[_save->getTileIndex(pos)])
 			continue;
-		int score = 0;
 		// i should really make a function for this
 		Position origin = pos.toVoxel() +
 			// 4 because -2 is eyes and 2 below that is the rifle (or at least that's my understanding)
 			Position(8,8, _unit->getHeight() + _unit->getFloatHeight() - tile->getTerrainLevel() - 4);
 
-		if (_save->getTileEngine()->canTargetUnit(&origin, _aggroTarget->getTile(), &target, _unit, false))
+		if (hasTargetInfo && _save->getTileEngine()->canTargetUnitFrom(origin, targetInfo, &target, _unit, false, trajectory))
 		{
 			_save->getPathfinding()->calculate(_unit, pos, BAM_NORMAL);
 			// can move here
 			if (_save->getPathfinding()->getStartDirection() != -1)
 			{
-				score = BASE_SYSTEMATIC_SUCCESS - getSpottingUnits(pos) * 10;
+				int score = BASE_SYSTEMATIC_SUCCESS - getSpottingUnits(pos) * 10;
 				score += _unit->getTimeUnits() - _save->getPathfinding()->getTotalTUCost();
 				if (!_aggroTarget->checkViewSector(pos))
 				{
@@ -1949,7 +1968,13 @@ int AIModule::explosiveEfficacy(Position targetPos, BattleUnit *attackingUnit, i
 		++efficacy;
 	}
 
-	for (auto* bu : *_save->getUnits())
+	// only units from the map area around the blast, `distance2d(a, b) <= radius` is same as `distance2dSq(a, b) <= radius * radius`
+	const int radiusSq = radius * radius;
+	const Position voxelPosA = Position (targetPos.toVoxel() + TileEngine::voxelTileCenter);
+	std::vector<Position> traj;
+	std::vector<BattleUnit*> units;
+	_save->getUnitsNear(targetPos, radius, units);
+	for (auto* bu : units)
 	{
 			// don't grenade dead guys
 		if (!bu->isOut() &&
@@ -1959,7 +1984,7 @@ int AIModule::explosiveEfficacy(Position targetPos, BattleUnit *attackingUnit, i
 			bu != target &&
 			// don't count units that probably won't be affected cause they're out of range
 			abs(bu->getPosition().z - targetPos.z) <= Options::battleExplosionHeight &&
-			Position::distance2d(bu->getPosition(), targetPos) <= radius)
+			Position::distance2dSq(bu->getPosition(), targetPos) <= radiusSq)
 		{
 				// don't count people who were already grenaded this turn
 			if (bu->getTile()->getDangerous() ||
@@ -1968,9 +1993,8 @@ int AIModule::explosiveEfficacy(Position targetPos, BattleUnit *attackingUnit, i
 				continue;
 
 			// trace a line from the grenade origin to the unit we're checking against
-			Position voxelPosA = Position (targetPos.toVoxel() + TileEngine::voxelTileCenter);
 			Position voxelPosB = Position (bu->getPosition().toVoxel() + TileEngine::voxelTileCenter);
-			std::vector<Position> traj;
+			traj.clear();
 			int collidesWith = _save->getTileEngine()->calculateLineVoxel(voxelPosA, voxelPosB, false, &traj, target, bu);
 
 			if (collidesWith == V_UNIT && traj.front().toTile() == bu->getPosition())
@@ -2781,6 +2805,9 @@ bool AIModule::getNodeOfBestEfficacy(BattleAction *action, int radius)
 	int bestScore = 2;
 	Position originVoxel = _save->getTileEngine()->getSightOriginVoxel(_unit);
 	Position targetVoxel;
+	// `distance2d(a, b) < radius` is same as `distance2dSq(a, b) <= (radius - 1) * (radius - 1)`
+	const int innerRadiusSq = radius > 0 ? (radius - 1) * (radius - 1) : -1;
+	std::vector<BattleUnit*> units;
 	for (const auto* node : *_save->getNodes())
 	{
 		if (node->isDummy())
@@ -2788,14 +2815,35 @@ bool AIModule::getNodeOfBestEfficacy(BattleAction *action, int radius)
 			continue;
 		}
 		int dist = Position::distance2d(node->getPosition(), _unit->getPosition());
-		if (dist <= 20 && dist > radius &&
-			_save->getTileEngine()->canTargetTile(&originVoxel, _save->getTile(node->getPosition()), O_FLOOR, &targetVoxel, _unit, false))
+		if (dist > 20 || dist <= radius)
+		{
+			continue;
+		}
+
+		// units that can be in blast, skip the node if even hitting all enemies there can't beat the best score
+		_save->getUnitsNear(node->getPosition(), radius, units);
+		int maxNodePoints = 0;
+		for (auto* bu : units)
+		{
+			if (!bu->isOut() && Position::distance2dSq(node->getPosition(), bu->getPosition()) <= innerRadiusSq &&
+				((_unit->getFaction() == FACTION_HOSTILE && bu->getFaction() != FACTION_HOSTILE) ||
+				(_unit->getFaction() == FACTION_NEUTRAL && bu->getFaction() == FACTION_HOSTILE)) &&
+				bu->getTurnsSinceSpotted() <= _intelligence)
+			{
+				++maxNodePoints;
+			}
+		}
+		if (maxNodePoints <= bestScore)
+		{
+			continue;
+		}
+
+		if (_save->getTileEngine()->canTargetTile(&originVoxel, _save->getTile(node->getPosition()), O_FLOOR, &targetVoxel, _unit, false))
 		{
 			int nodePoints = 0;
-			for (auto* bu : *_save->getUnits())
+			for (auto* bu : units)
 			{
-				dist = Position::distance2d(node->getPosition(), bu->getPosition());
-				if (!bu->isOut() && dist < radius)
+				if (!bu->isOut() && Position::distance2dSq(node->getPosition(), bu->getPosition()) <= innerRadiusSq)
 				{
 					Position targetOriginVoxel = _save->getTileEngine()->getSightOriginVoxel(bu);
 					if (_save->getTileEngine()->canTargetTile(&targetOriginVoxel, _save->getTile(node->getPosition()), O_FLOOR, &targetVoxel, bu, false))
@@ -61,6 +61,8 @@ private:
 	int selectNearestTargetLeeroy(bool canRun);
 	void meleeActionLeeroy(bool canRun);
 	void dont_think(BattleAction *action);
+	/// Gets a lookup by tile index of tiles reachable with enough TU left for attack.
+	std::vector<bool> getReachableWithAttackLookup() const;
 public:
 	/// Creates a new AIModule linked to the game and a certain unit.
 	AIModule(SavedBattleGame *save, BattleUnit *unit, Node *node);
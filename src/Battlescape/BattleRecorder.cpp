@@ -0,0 +1,366 @@
+/*
+ * Copyright 2010-2023 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "BattleRecorder.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+#ifdef __GNUG__
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+#include "BattleState.h"
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/Logger.h"
+#include "../Engine/Options.h"
+#include "../Engine/RNG.h"
+#include "../Savegame/BattleItem.h"
+#include "../Savegame/BattleUnit.h"
+#include "../Savegame/SavedBattleGame.h"
+#include "../Savegame/Tile.h"
+
+namespace OpenXcom
+{
+
+namespace BattleRecorder
+{
+
+namespace
+{
+
+/**
+ * Time statistics of one battle state type.
+ */
+struct StateStats
+{
+	Uint64 count = 0;
+	Uint64 thinks = 0;
+	Uint64 totalTime = 0;
+	Uint64 maxTime = 0;
+};
+
+bool _recording = false;
+std::ostringstream _record;
+std::unordered_map<std::string, StateStats> _stats;
+std::unordered_map<std::type_index, std::string> _typeNames;
+std::string _filename;
+int _stage = 1;
+bool _nextStage = false;
+
+/// Lines of the previous record of the same battle, to check the new one against.
+std::vector<std::string> _expected;
+size_t _line = 0;
+bool _diverged = false;
+
+/**
+ * Gets readable name of a battle state type, without the namespace.
+ */
+const std::string &typeName(const std::type_info &type)
+{
+	auto it = _typeNames.find(type);
+	if (it != _typeNames.end())
+	{
+		return it->second;
+	}
+	std::string name = type.name();
+#ifdef __GNUG__
+	int status = 0;
+	char *demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+	if (status == 0 && demangled)
+	{
+		name = demangled;
+	}
+	std::free(demangled);
+#endif
+	for (const char *prefix : { "class ", "struct ", "OpenXcom::" })
+	{
+		if (name.compare(0, strlen(prefix), prefix) == 0)
+		{
+			name.erase(0, strlen(prefix));
+		}
+	}
+	return _typeNames[type] = name;
+}
+
+/**
+ * Gets readable name of the type of a battle state.
+ */
+const std::string &stateName(const BattleState *state)
+{
+	return typeName(typeid(*state));
+}
+
+/**
+ * Adds a line to the record and checks it against the previous record.
+ */
+void addLine(const std::string &line)
+{
+	_record << line << "\n";
+	if (_diverged || _line >= _expected.size())
+	{
+		return;
+	}
+	if (_expected[_line] != line)
+	{
+		_diverged = true;
+		Log(LOG_WARNING) << "Battle differs from the previous record at line " << _line + 1 << ":";
+		Log(LOG_WARNING) << "  expected: " << _expected[_line];
+		Log(LOG_WARNING) << "  got:      " << line;
+	}
+	++_line;
+}
+
+/**
+ * Loads the lines of the previous record from the file, up to the timings.
+ */
+void loadExpected(const std::string &filename)
+{
+	_expected.clear();
+	_line = 0;
+	_diverged = false;
+	if (!CrossPlatform::fileExists(filename))
+	{
+		return;
+	}
+	auto file = CrossPlatform::readFile(filename);
+	std::string line;
+	while (std::getline(*file, line) && line != "timings:")
+	{
+		_expected.push_back(line);
+	}
+}
+
+/**
+ * Formats nanoseconds as milliseconds.
+ */
+std::string toMs(Uint64 ns)
+{
+	std::ostringstream ss;
+	ss << std::fixed << std::setprecision(3) << ns / 1000000.0;
+	return ss.str();
+}
+
+/**
+ * Mixes a value into FNV-1a hash.
+ */
+void hashAdd(Uint64 &hash, Sint64 value)
+{
+	for (int i = 0; i < 8; ++i)
+	{
+		hash ^= (Uint64)(value >> (i * 8)) & 0xFF;
+		hash *= 0x100000001B3ULL;
+	}
+}
+
+/**
+ * Mixes a position into FNV-1a hash.
+ */
+void hashAdd(Uint64 &hash, Position pos)
+{
+	hashAdd(hash, pos.x);
+	hashAdd(hash, pos.y);
+	hashAdd(hash, pos.z);
+}
+
+}
+
+/**
+ * Starts recording a battle, anything recorded before is dropped.
+ * If this battle was recorded before, the new record is checked against that one.
+ * @param save The battle.
+ */
+void start(SavedBattleGame *save)
+{
+	_stage = _nextStage ? _stage + 1 : 1;
+	_nextStage = false;
+	_filename = Options::getMasterUserFolder() + "battle_record_" + CrossPlatform::sanitizeFilename(save->getMissionType()) + "_stage" + std::to_string(_stage) + ".txt";
+	loadExpected(_filename);
+
+	_recording = true;
+	_record.str("");
+	_record.clear();
+	_stats.clear();
+	addLine("battle: " + save->getMissionType() + " stage " + std::to_string(_stage));
+	std::ostringstream line;
+	line << "start: turn " << save->getTurn() << " side " << save->getSide() << " seed " << RNG::getSeed() << " hash " << std::hex << hashBattle(save);
+	addLine(line.str());
+}
+
+/**
+ * Marks that the battle continues with the next stage of the mission,
+ * so the next record is numbered as that stage instead of overwriting this one.
+ */
+void nextStage()
+{
+	_nextStage = true;
+}
+
+/**
+ * Records a battle state added to the queue, this covers both player and AI actions.
+ * @param save The battle.
+ * @param state The new state.
+ */
+void addState(SavedBattleGame *save, const BattleState *state)
+{
+	if (!_recording || !state)
+	{
+		return;
+	}
+	const auto& action = state->getAction();
+	const auto& name = stateName(state);
+	_stats[name].count += 1;
+	std::ostringstream line;
+	line << "  state: " << name
+		<< " turn " << save->getTurn()
+		<< " side " << save->getSide()
+		<< " action " << action.type
+		<< " actor " << (action.actor ? action.actor->getId() : -1)
+		<< " weapon " << (action.weapon ? action.weapon->getId() : -1)
+		<< " target " << action.target
+		<< " seed " << RNG::getSeed();
+	addLine(line.str());
+}
+
+/**
+ * Records time spent in one think of a battle state.
+ * @param stateType Type of the state, taken before think as the state can delete itself.
+ * @param nanoseconds Time taken.
+ */
+void addStateTime(const std::type_info &stateType, Uint64 nanoseconds)
+{
+	if (!_recording)
+	{
+		return;
+	}
+	auto &stats = _stats[typeName(stateType)];
+	stats.thinks += 1;
+	stats.totalTime += nanoseconds;
+	stats.maxTime = std::max(stats.maxTime, nanoseconds);
+}
+
+/**
+ * Records a turn boundary, with RNG seed and hash of the battle state.
+ * @param save The battle.
+ */
+void addTurn(SavedBattleGame *save)
+{
+	if (!_recording)
+	{
+		return;
+	}
+	std::ostringstream line;
+	line << "turn: " << save->getTurn() << " side " << save->getSide() << " seed " << RNG::getSeed() << " hash " << std::hex << hashBattle(save);
+	addLine(line.str());
+}
+
+/**
+ * Writes the record and timings to the user folder and the timings to the log,
+ * reports how the record compares to the previous one, then stops recording.
+ */
+void finish()
+{
+	if (!_recording)
+	{
+		return;
+	}
+	_recording = false;
+
+	std::vector<std::pair<std::string, StateStats>> sorted(_stats.begin(), _stats.end());
+	std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) { return a.second.totalTime > b.second.totalTime; });
+
+	Log(LOG_INFO) << "Battle state timings:";
+	Log(LOG_INFO) << "  total ms | max ms | thinks | count | state";
+	_record << "timings:\n";
+	for (const auto &p : sorted)
+	{
+		std::ostringstream line;
+		line << toMs(p.second.totalTime) << " | " << toMs(p.second.maxTime) << " | " << p.second.thinks << " | " << p.second.count << " | " << p.first;
+		Log(LOG_INFO) << "  " << line.str();
+		_record << "  " << line.str() << "\n";
+	}
+
+	if (!_expected.empty())
+	{
+		if (!_diverged)
+		{
+			Log(LOG_INFO) << "Battle matches the previous record for " << _line << " of its " << _expected.size() << " lines";
+		}
+		CrossPlatform::moveFile(_filename, _filename + ".prev");
+	}
+	if (!CrossPlatform::writeFile(_filename, _record.str()))
+	{
+		Log(LOG_ERROR) << "Failed to write " << _filename;
+	}
+	_record.str("");
+	_record.clear();
+	_stats.clear();
+	_expected.clear();
+}
+
+/**
+ * Calculates a hash of the battle state that matters for determinism:
+ * units, items, and fire and smoke on the map.
+ * @param save The battle.
+ * @return Hash value.
+ */
+Uint64 hashBattle(SavedBattleGame *save)
+{
+	Uint64 hash = 0xCBF29CE484222325ULL;
+	hashAdd(hash, save->getTurn());
+	hashAdd(hash, save->getSide());
+	for (const auto* bu : *save->getUnits())
+	{
+		hashAdd(hash, bu->getId());
+		hashAdd(hash, bu->getPosition());
+		hashAdd(hash, bu->getDirection());
+		hashAdd(hash, bu->getStatus());
+		hashAdd(hash, bu->getFaction());
+		hashAdd(hash, bu->getTimeUnits());
+		hashAdd(hash, bu->getEnergy());
+		hashAdd(hash, bu->getHealth());
+		hashAdd(hash, bu->getStunlevel());
+		hashAdd(hash, bu->getMorale());
+	}
+	for (const auto* bi : *save->getItems())
+	{
+		hashAdd(hash, bi->getId());
+		hashAdd(hash, bi->getOwner() ? bi->getOwner()->getId() : -1);
+		hashAdd(hash, bi->getTile() ? bi->getTile()->getPosition() : Position(-1, -1, -1));
+	}
+	for (int i = 0; i < save->getMapSizeXYZ(); ++i)
+	{
+		const auto* tile = save->getTile(i);
+		if (tile->getFire() || tile->getSmoke())
+		{
+			hashAdd(hash, i);
+			hashAdd(hash, tile->getFire());
+			hashAdd(hash, tile->getSmoke());
+		}
+	}
+	return hash;
+}
+
+}
+
+}
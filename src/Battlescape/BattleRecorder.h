@@ -0,0 +1,58 @@
+#pragma once
+/*
+ * Copyright 2010-2023 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <typeinfo>
+#include <SDL_types.h>
+
+namespace OpenXcom
+{
+
+class SavedBattleGame;
+class BattleState;
+
+/**
+ * Records the course of a battle when `oxceBattleRecorder` is enabled:
+ * every battle state started by the player or the AI, with the RNG seed at that moment,
+ * and a checkpoint at every turn boundary with a hash of the battle state.
+ * Each stage of a mission gets its own record file, named after the mission type and stage.
+ * Two runs from the same save that take the same actions produce identical records,
+ * so when a record already exists, the new run is checked against it as it goes
+ * and the first differing line is logged. The old record is kept with a `.prev` suffix.
+ * Time spent in each battle state type is reported too.
+ * Only meant to be used from the main thread.
+ */
+namespace BattleRecorder
+{
+	/// Starts recording a battle.
+	void start(SavedBattleGame *save);
+	/// Marks that the battle continues with the next stage of the mission.
+	void nextStage();
+	/// Records a battle state added to the queue.
+	void addState(SavedBattleGame *save, const BattleState *state);
+	/// Records time spent in one think of a battle state.
+	void addStateTime(const std::type_info &stateType, Uint64 nanoseconds);
+	/// Records a turn boundary.
+	void addTurn(SavedBattleGame *save);
+	/// Writes the record and timings to the user folder and stops recording.
+	void finish();
+	/// Calculates a hash of the battle state.
+	Uint64 hashBattle(SavedBattleGame *save);
+}
+
+}
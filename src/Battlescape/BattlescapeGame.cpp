@@ -16,13 +16,16 @@
  * You should have received a copy of the GNU General Public License
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <chrono>
 #include <sstream>
+#include <typeinfo>
 #include "BattlescapeGame.h"
 #include "BattlescapeState.h"
 #include "Map.h"
 #include "Camera.h"
 #include "NextTurnState.h"
 #include "BattleState.h"
+#include "BattleRecorder.h"
 #include "UnitTurnBState.h"
 #include "UnitWalkBState.h"
 #include "ProjectileFlyBState.h"
@@ -192,6 +195,11 @@ BattlescapeGame::BattlescapeGame(SavedBattleGame *save, BattlescapeState *parent
 
 	_debugPlay = false;
 
+	if (Options::oxceBattleRecorder && !_save->isPreview())
+	{
+		BattleRecorder::start(_save);
+	}
+
 	checkForCasualties(nullptr, BattleActionAttack{ }, true);
 	cancelCurrentAction();
 }
@@ -202,6 +210,7 @@ BattlescapeGame::BattlescapeGame(SavedBattleGame *save, BattlescapeState *parent
  */
 BattlescapeGame::~BattlescapeGame()
 {
+	BattleRecorder::finish();
 	for (auto* bs : _states)
 	{
 		delete bs;
@@ -624,6 +633,8 @@ void BattlescapeGame::endTurn()
 	_save->getTileEngine()->calculateLighting(LL_FIRE, TileEngine::invalid, 0, true);
 	_save->getTileEngine()->recalculateFOV();
 
+	if (Options::oxceBattleRecorder) BattleRecorder::addTurn(_save);
+
 	// Calculate values
 	BattlescapeTally tally = _save->getBattleGame()->tallyUnits();
 
@@ -1125,6 +1136,15 @@ void BattlescapeGame::handleState()
 			endTurn();
 			return;
 		}
+		else if (Options::oxceBattleRecorder)
+		{
+			// state can pop itself in `think`, type is taken before it
+			const auto& type = typeid(*_states.front());
+			const auto start = std::chrono::steady_clock::now();
+			_states.front()->think();
+			const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+			BattleRecorder::addStateTime(type, time.count());
+		}
 		else
 		{
 			_states.front()->think();
@@ -1139,6 +1159,7 @@ void BattlescapeGame::handleState()
  */
 void BattlescapeGame::statePushFront(BattleState *bs)
 {
+	if (Options::oxceBattleRecorder) BattleRecorder::addState(_save, bs);
 	_states.push_front(bs);
 	bs->init();
 }
@@ -1149,6 +1170,7 @@ void BattlescapeGame::statePushFront(BattleState *bs)
  */
 void BattlescapeGame::statePushNext(BattleState *bs)
 {
+	if (Options::oxceBattleRecorder) BattleRecorder::addState(_save, bs);
 	if (_states.empty())
 	{
 		_states.push_front(bs);
@@ -1167,6 +1189,7 @@ void BattlescapeGame::statePushNext(BattleState *bs)
  */
 void BattlescapeGame::statePushBack(BattleState *bs)
 {
+	if (Options::oxceBattleRecorder) BattleRecorder::addState(_save, bs);
 	if (_states.empty())
 	{
 		_states.push_front(bs);
@@ -2333,6 +2356,9 @@ void BattlescapeGame::removeSummonedPlayerUnits()
 {
 	std::vector<Unit*> resummonAsCivilians;
 
+	// unit indexes will shift
+	_save->invalidateUnitGrid();
+
 	auto buIt = _save->getUnits()->begin();
 	while (buIt != _save->getUnits()->end())
 	{
@@ -39,7 +39,6 @@
 #include "../Savegame/AlienBase.h"
 #include "../Savegame/EquipmentLayoutItem.h"
 #include "../Engine/Game.h"
-#include "../Engine/FileMap.h"
 #include "../Engine/Options.h"
 #include "../Engine/RNG.h"
 #include "../Engine/Exception.h"
@@ -1043,7 +1042,7 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 		for (auto* soldier : *_base->getSoldiers())
 		{
 			if ((_craft != 0 && soldier->getCraft() == _craft) ||
-				(_craft == 0 && (soldier->hasFullHealth() || soldier->canDefendBase()) && (soldier->getCraft() == 0 || soldier->getCraft()->getStatus() != "STR_OUT")))
+				(_craft == 0 && (soldier->hasFullHealth() || soldier->canDefendBase()) && (soldier->getCraft() == 0 || soldier->getCraft()->getStatus() != CRAFT_OUT)))
 			{
 				Armor* transformedArmor = nullptr;
 				if (enviro)
@@ -1085,7 +1084,7 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 				continue;
 			}
 			if ((_craft != 0 && soldier->getCraft() == _craft) ||
-				(_craft == 0 && (soldier->hasFullHealth() || soldier->canDefendBase()) && (soldier->getCraft() == 0 || soldier->getCraft()->getStatus() != "STR_OUT")))
+				(_craft == 0 && (soldier->hasFullHealth() || soldier->canDefendBase()) && (soldier->getCraft() == 0 || soldier->getCraft()->getStatus() != CRAFT_OUT)))
 			{
 				// clear the soldier's equipment layout, we want to start fresh
 				if (_game->getSavedGame()->getDisableSoldierEquipment())
@@ -1131,7 +1130,7 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 				continue;
 			}
 			if ((_craft != 0 && soldier->getCraft() == _craft) ||
-				(_craft == 0 && (soldier->hasFullHealth() || soldier->canDefendBase()) && (soldier->getCraft() == 0 || soldier->getCraft()->getStatus() != "STR_OUT")))
+				(_craft == 0 && (soldier->hasFullHealth() || soldier->canDefendBase()) && (soldier->getCraft() == 0 || soldier->getCraft()->getStatus() != CRAFT_OUT)))
 			{
 				// clear the soldier's equipment layout, we want to start fresh
 				if (_game->getSavedGame()->getDisableSoldierEquipment())
@@ -1247,7 +1246,7 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 		// add items from crafts in base
 		for (auto* craft : *_base->getCrafts())
 		{
-			if (craft->getStatus() == "STR_OUT")
+			if (craft->getStatus() == CRAFT_OUT)
 				continue;
 			for (const auto& pair : *craft->getItems()->getContents())
 			{
@@ -2021,18 +2020,19 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, int zo
 {
 	int sizex, sizey, sizez;
 	int x = xoff, y = yoff, z = zoff;
-	char size[3];
-	unsigned char value[4];
 	std::string filename = "MAPS/" + mapblock->getName() + ".MAP";
 	unsigned int terrainObjectID;
 
-	// Load file
-	auto mapFile = FileMap::getIStream(filename);
+	// Load file, it stays cached in the map block
+	const auto& mapFile = mapblock->getMapFile();
+	if (mapFile.size() < 3)
+	{
+		throw Exception("Invalid MAP file: " + filename);
+	}
 
-	mapFile->read((char*)&size, sizeof(size));
-	sizey = (int)size[0];
-	sizex = (int)size[1];
-	sizez = (int)size[2];
+	sizey = (int)(char)mapFile[0];
+	sizex = (int)(char)mapFile[1];
+	sizez = (int)(char)mapFile[2];
 
 	mapblock->setSizeZ(sizez);
 
@@ -2082,8 +2082,9 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, int zo
 		throw Exception("Something is wrong in your map definitions, craft/ufo map is too tall?");
 	}
 
-	while (mapFile->read((char*)&value, sizeof(value)))
+	for (size_t offset = 3; offset + 4 <= mapFile.size(); offset += 4)
 	{
+		const unsigned char *value = &mapFile[offset];
 		for (int part = O_FLOOR; part < O_MAX; ++part)
 		{
 			terrainObjectID = ((unsigned char)value[part]);
@@ -2117,11 +2118,6 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, int zo
 		}
 	}
 
-	if (!mapFile->eof())
-	{
-		throw Exception("Invalid MAP file: " + filename);
-	}
-
 	// Add the craft offset to the positions of the items if we're loading a craft map
 	// But don't do so if loading a verticalLevel, since the z offset of the craft is handled by that code
 	if (craft && zoff == 0)
@@ -2217,16 +2213,16 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, int zo
  */
 void BattlescapeGenerator::loadRMP(MapBlock *mapblock, int xoff, int yoff, int zoff, int segment)
 {
-	unsigned char value[24];
 	std::string filename = "ROUTES/" + mapblock->getName() +".RMP";
-	// Load file
-	auto mapFile = FileMap::getIStream(filename);
+	// Load file, it stays cached in the map block
+	const auto& mapFile = mapblock->getRouteFile();
 
 	size_t nodeOffset = _save->getNodes()->size();
 	std::vector<int> badNodes;
 	int nodesAdded = 0;
-	while (mapFile->read((char*)&value, sizeof(value)))
+	for (size_t offset = 0; offset + 24 <= mapFile.size(); offset += 24)
 	{
+		const unsigned char *value = &mapFile[offset];
 		int pos_x = value[1];
 		int pos_y = value[0];
 		int pos_z = value[2];
@@ -2293,11 +2289,6 @@ void BattlescapeGenerator::loadRMP(MapBlock *mapblock, int xoff, int yoff, int z
 			nodeCounter--;
 		}
 	}
-
-	if (!mapFile->eof())
-	{
-		throw Exception("Invalid RMP file: " + filename);
-	}
 }
 
 /**
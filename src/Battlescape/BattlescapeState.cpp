@@ -39,6 +39,7 @@
 #include "DebriefingState.h"
 #include "MiniMapState.h"
 #include "BattlescapeGenerator.h"
+#include "BattleRecorder.h"
 #include "BriefingState.h"
 #include "ExtendedBattlescapeLinksState.h"
 #include "../lodepng.h"
@@ -3272,6 +3273,7 @@ void BattlescapeState::finishBattle(bool abort, int inExitArea)
 		// if there is a next mission stage + we have people in exit area OR we killed all aliens, load the next stage
 		_popups.clear();
 		_save->setMissionType(nextStage);
+		if (Options::oxceBattleRecorder) BattleRecorder::nextStage();
 		BattlescapeGenerator bgen = BattlescapeGenerator(_game);
 		bgen.nextStage();
 		_game->popState();
@@ -18,6 +18,7 @@
  */
 #include <assert.h>
 #include <set>
+#include <unordered_set>
 #include "TileEngine.h"
 #include "AIModule.h"
 #include "Map.h"
@@ -877,6 +878,51 @@ void iterateTilesLightMaxBound(SavedBattleGame* save, Position position, int eve
 	iterateVolume(Pos{position.x, position.y, position.z}, eventRadius, maxRange, gsMap, save->getMapSizeZ(), callback);
 }
 
+/**
+ * Directions of explosion rays, `fi` is elevation from -90 to 90 in 5 degree steps
+ * and `te` is heading from 0 to 360 in 3 degree steps.
+ */
+struct ExplosionDirections
+{
+	static constexpr int FiSize = 37;
+	static constexpr int TeSize = 121;
+
+	double sinFi[FiSize], cosFi[FiSize];
+	double sinTe[TeSize], cosTe[TeSize];
+
+	ExplosionDirections()
+	{
+		for (int i = 0; i < FiSize; ++i)
+		{
+			sinFi[i] = sin(Deg2Rad(-90 + i * 5));
+			cosFi[i] = cos(Deg2Rad(-90 + i * 5));
+		}
+		for (int i = 0; i < TeSize; ++i)
+		{
+			sinTe[i] = sin(Deg2Rad(i * 3));
+			cosTe[i] = cos(Deg2Rad(i * 3));
+		}
+	}
+};
+
+const ExplosionDirections explosionDirections;
+
+/**
+ * Hash of tiles visited by one explosion ray.
+ */
+struct ExplosionRayHash
+{
+	size_t operator()(const std::vector<Tile*>& ray) const
+	{
+		size_t h = ray.size();
+		for (auto* t : ray)
+		{
+			h = h * 31 + std::hash<const Tile*>()(t);
+		}
+		return h;
+	}
+};
+
 } // namespace
 
 constexpr int TileEngine::heightFromCenter[11];
@@ -903,6 +949,8 @@ TileEngine::TileEngine(SavedBattleGame *save, Mod *mod) :
 	_blockVisibility.resize(save->getMapSizeXYZ());
 	_lightPropagationTerrainBlocking.resize(save->getMapSizeXYZ());
 	_lightPropagationTempNeedUpdate.resize(save->getMapSizeXYZ());
+	_explosionPower.resize(save->getMapSizeXYZ());
+	_explosionGeneration.resize(save->getMapSizeXYZ());
 	_cacheTilePos = invalid;
 
 	if (Options::oxceTogglePersonalLightType == 2)
@@ -1198,9 +1246,13 @@ void TileEngine::calculateLighting(LightLayers layer, Position position, int eve
 		iterateTiles(
 			_save,
 			gsStatic,
-			[&](Tile* tile, int index)
+			[&](int index)
 			{
-				if (_lightPropagationTempNeedUpdate[index]) tile->resetLightMulti(layer);
+				if (_lightPropagationTempNeedUpdate[index])
+				{
+					auto& levels = _save->getTileLight(index);
+					std::fill(levels.begin() + layer, levels.end(), 0);
+				}
 			}
 		);
 	}
@@ -1208,9 +1260,13 @@ void TileEngine::calculateLighting(LightLayers layer, Position position, int eve
 	iterateTiles(
 		_save,
 		gsDynamic,
-		[&](Tile* tile, int index)
+		[&](int index)
 		{
-			if (_lightPropagationTempNeedUpdate[index]) tile->resetLightMulti(std::max(layer, LL_ITEMS));
+			if (_lightPropagationTempNeedUpdate[index])
+			{
+				auto& levels = _save->getTileLight(index);
+				std::fill(levels.begin() + std::max(layer, LL_ITEMS), levels.end(), 0);
+			}
 		}
 	);
 
@@ -1628,7 +1684,6 @@ void TileEngine::calculateTilesInFOV(BattleUnit *unit, const Position eventPos,
 										if (!unit->hasVisibleTile(_save->getTile(posVisited)))
 										{
 											unit->addToVisibleTiles(_save->getTile(posVisited));
-											_save->getTile(posVisited)->setVisible(+1);
 											_save->getTile(posVisited)->setDiscovered(true, O_FLOOR);
 
 											// walls to the east or south of a visible tile, we see that too
@@ -2112,9 +2167,27 @@ int TileEngine::checkVoxelExposure(Position *originVoxel, Tile *tile, BattleUnit
  */
 bool TileEngine::canTargetUnit(Position *originVoxel, Tile *tile, Position *scanVoxel, BattleUnit *excludeUnit, bool rememberObstacles, BattleUnit *potentialUnit)
 {
-	Position targetVoxel = tile->getPosition().toVoxel() + Position(7, 8, 0);
+	UnitTargetInfo info;
+	if (!getUnitTargetInfo(tile, excludeUnit, potentialUnit, info))
+	{
+		return false;
+	}
 	std::vector<Position> _trajectory;
-	bool hypothetical = potentialUnit != 0;
+	return canTargetUnitFrom(*originVoxel, info, scanVoxel, excludeUnit, rememberObstacles, _trajectory);
+}
+
+/**
+ * Prepares the part of the line of fire check that depends only on the target.
+ * @param tile The tile to check for.
+ * @param excludeUnit is self (not to hit self).
+ * @param potentialUnit is a hypothetical unit, or null to use unit on tile.
+ * @param info Returned target data.
+ * @return False if there is nothing to target.
+ */
+bool TileEngine::getUnitTargetInfo(Tile *tile, BattleUnit *excludeUnit, BattleUnit *potentialUnit, UnitTargetInfo &info) const
+{
+	info.targetVoxel = tile->getPosition().toVoxel() + Position(7, 8, 0);
+	info.hypothetical = potentialUnit != 0;
 	if (potentialUnit == 0)
 	{
 		potentialUnit = tile->getUnit();
@@ -2123,29 +2196,21 @@ bool TileEngine::canTargetUnit(Position *originVoxel, Tile *tile, Position *scan
 
 	if (potentialUnit == excludeUnit) return false; //skip self
 
-	int targetMinHeight = targetVoxel.z - tile->getTerrainLevel();
-	targetMinHeight += potentialUnit->getFloatHeight();
+	info.targetMinHeight = info.targetVoxel.z - tile->getTerrainLevel();
+	info.targetMinHeight += potentialUnit->getFloatHeight();
 
-	int targetMaxHeight = targetMinHeight;
-	int targetCenterHeight;
+	info.targetMaxHeight = info.targetMinHeight;
 	// if there is an other unit on target tile, we assume we want to check against this unit's height
 	int heightRange;
 
-	int unitRadius = potentialUnit->getLoftemps(); //width == loft in default loftemps set
-	int targetSize = potentialUnit->getArmor()->getSize() - 1;
-	int xOffset = potentialUnit->getPosition().x - tile->getPosition().x;
-	int yOffset = potentialUnit->getPosition().y - tile->getPosition().y;
-	if (targetSize > 0)
+	info.unitRadius = potentialUnit->getLoftemps(); //width == loft in default loftemps set
+	info.targetSize = potentialUnit->getArmor()->getSize() - 1;
+	info.xOffset = potentialUnit->getPosition().x - tile->getPosition().x;
+	info.yOffset = potentialUnit->getPosition().y - tile->getPosition().y;
+	if (info.targetSize > 0)
 	{
-		unitRadius = 3;
+		info.unitRadius = 3;
 	}
-	// vector manipulation to make scan work in view-space
-	Position relPos = targetVoxel - *originVoxel;
-	float normal = unitRadius/sqrt((float)(relPos.x*relPos.x + relPos.y*relPos.y));
-	int relX = floor(((float)relPos.y)*normal+0.5);
-	int relY = floor(((float)-relPos.x)*normal+0.5);
-
-	int sliceTargets[] = {0,0, relX,relY, -relX,-relY, relY,-relX, -relY,relX};
 
 	if (!potentialUnit->isOut())
 	{
@@ -2156,41 +2221,64 @@ bool TileEngine::canTargetUnit(Position *originVoxel, Tile *tile, Position *scan
 		heightRange = 12;
 	}
 
-	targetMaxHeight += heightRange;
-	targetCenterHeight=(targetMaxHeight+targetMinHeight)/2;
+	info.targetMaxHeight += heightRange;
+	info.targetCenterHeight = (info.targetMaxHeight + info.targetMinHeight) / 2;
 	heightRange/=2;
 	if (heightRange>10) heightRange=10;
 	if (heightRange<=0) heightRange=0;
+	info.heightRange = heightRange;
+	return true;
+}
+
+/**
+ * Checks line of fire from one origin to a unit described by prepared target data.
+ * @param originVoxel Voxel of trace origin (eye or gun's barrel).
+ * @param info Target data from getUnitTargetInfo.
+ * @param scanVoxel is returned coordinate of hit.
+ * @param excludeUnit is self (not to hit self).
+ * @param rememberObstacles Remember obstacles for no LOF indicator?
+ * @param _trajectory Buffer for traced voxels.
+ * @return True if the unit can be targetted.
+ */
+bool TileEngine::canTargetUnitFrom(const Position &originVoxel, const UnitTargetInfo &info, Position *scanVoxel, BattleUnit *excludeUnit, bool rememberObstacles, std::vector<Position> &_trajectory)
+{
+	// vector manipulation to make scan work in view-space
+	Position relPos = info.targetVoxel - originVoxel;
+	float normal = info.unitRadius/sqrt((float)(relPos.x*relPos.x + relPos.y*relPos.y));
+	int relX = floor(((float)relPos.y)*normal+0.5);
+	int relY = floor(((float)-relPos.x)*normal+0.5);
+
+	int sliceTargets[] = {0,0, relX,relY, -relX,-relY, relY,-relX, -relY,relX};
 
 	// scan ray from top to bottom  plus different parts of target cylinder
-	for (int i = 0; i <= heightRange; ++i)
+	for (int i = 0; i <= info.heightRange; ++i)
 	{
-		scanVoxel->z=targetCenterHeight+heightFromCenter[i];
+		scanVoxel->z=info.targetCenterHeight+heightFromCenter[i];
 		for (int j = 0; j < 5; ++j)
 		{
-			if (i < (heightRange-1) && j>2) break; //skip unnecessary checks
-			scanVoxel->x=targetVoxel.x + sliceTargets[j*2];
-			scanVoxel->y=targetVoxel.y + sliceTargets[j*2+1];
+			if (i < (info.heightRange-1) && j>2) break; //skip unnecessary checks
+			scanVoxel->x=info.targetVoxel.x + sliceTargets[j*2];
+			scanVoxel->y=info.targetVoxel.y + sliceTargets[j*2+1];
 			_trajectory.clear();
-			int test = calculateLineVoxel(*originVoxel, *scanVoxel, false, &_trajectory, excludeUnit);
+			int test = calculateLineVoxel(originVoxel, *scanVoxel, false, &_trajectory, excludeUnit);
 			if (test == V_UNIT)
 			{
-				for (int x = 0; x <= targetSize; ++x)
+				for (int x = 0; x <= info.targetSize; ++x)
 				{
-					for (int y = 0; y <= targetSize; ++y)
+					for (int y = 0; y <= info.targetSize; ++y)
 					{
 						//voxel of hit must be inside of scanned box
-						if (_trajectory.at(0).x/16 == (scanVoxel->x/16) + x + xOffset &&
-							_trajectory.at(0).y/16 == (scanVoxel->y/16) + y + yOffset &&
-							_trajectory.at(0).z >= targetMinHeight &&
-							_trajectory.at(0).z <= targetMaxHeight)
+						if (_trajectory.at(0).x/16 == (scanVoxel->x/16) + x + info.xOffset &&
+							_trajectory.at(0).y/16 == (scanVoxel->y/16) + y + info.yOffset &&
+							_trajectory.at(0).z >= info.targetMinHeight &&
+							_trajectory.at(0).z <= info.targetMaxHeight)
 						{
 							return true;
 						}
 					}
 				}
 			}
-			else if (test == V_EMPTY && hypothetical && !_trajectory.empty())
+			else if (test == V_EMPTY && info.hypothetical && !_trajectory.empty())
 			{
 				return true;
 			}
@@ -2487,7 +2575,8 @@ std::vector<TileEngine::ReactionScore> TileEngine::getSpottingUnits(BattleUnit*
 	// no reaction on civilian turn.
 	if (_save->getSide() != FACTION_NEUTRAL)
 	{
-		for (auto* bu : *_save->getUnits())
+		_save->getUnitsNear(unit->getPosition(), getMaxViewDistance(), _nearUnits);
+		for (auto* bu : _nearUnits)
 		{
 				// not dead/unconscious
 			if (!bu->isOut() &&
@@ -3213,9 +3302,17 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 	int hitSide = 0;
 	int diagonalWall = 0;
 	int power_;
-	std::map<Tile*, int> tilesAffected;
+	std::vector<int> tilesAffected;
 	std::vector<BattleItem*> toRemove;
-	std::pair<std::map<Tile*, int>::iterator, bool> ret;
+	std::vector<Tile*> ray;
+	std::unordered_set<std::vector<Tile*>, ExplosionRayHash> raysDone[7];
+
+	// new generation makes all tiles unaffected without clearing the whole buffer
+	if (++_explosionCurrentGeneration == 0)
+	{
+		std::fill(_explosionGeneration.begin(), _explosionGeneration.end(), 0);
+		_explosionCurrentGeneration = 1;
+	}
 
 	if (type->FireBlastCalc)
 	{
@@ -3248,33 +3345,62 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 			hitSide = (center.x % 16 + center.y % 16 - 15) > 0 ? 1 : -1;
 	}
 
-	for (int fi = -90; fi <= 90; fi += 5)
+	for (int fiIndex = 0; fiIndex < ExplosionDirections::FiSize; ++fiIndex)
 	{
 		// raytrace every 3 degrees makes sure we cover all tiles in a circle.
-		for (int te = 0; te <= 360; te += 3)
-		{
-			double cos_te = cos(Deg2Rad(te));
-			double sin_te = sin(Deg2Rad(te));
-			double sin_fi = sin(Deg2Rad(fi));
-			double cos_fi = cos(Deg2Rad(fi));
+		for (int teIndex = 0; teIndex < ExplosionDirections::TeSize; ++teIndex)
+		{
+			const int te = teIndex * 3;
+			const double cos_te = explosionDirections.cosTe[teIndex];
+			const double sin_te = explosionDirections.sinTe[teIndex];
+			const double sin_fi = explosionDirections.sinFi[fiIndex];
+			const double cos_fi = explosionDirections.cosFi[fiIndex];
+
+			// tiles visited by this ray, near vertical rays and short radius make lot of them identical.
+			// blockage depends only on terrain that is not changed until detonation,
+			// so ray that repeats an earlier one can't reach or damage anything new.
+			ray.clear();
+			for (double l = 1; l <= maxRadius; l += 1.0)
+			{
+				Tile *t = _save->getTile(Position(
+					int(floor(centetTile.x + 0.5 + l * sin_te * cos_fi)),
+					int(floor(centetTile.y + 0.5 + l * cos_te * cos_fi)),
+					int(floor(centetTile.z + 0.5 + l * sin_fi))
+				));
+				if (!t) break;
+				ray.push_back(t);
+			}
+			// first step around bigwall depends on heading too
+			const int sector = diagonalWall ? (te >= 45) + (te >= 135) + (te > 225) + (te >= 225) + (te > 315) + (te >= 315) : 0;
+			if (!raysDone[sector].insert(ray).second)
+			{
+				continue;
+			}
 
 			origin = _save->getTile(centetTile);
 			dest = origin;
 			double l = 0;
-			int tileX, tileY, tileZ;
+			size_t step = 0;
 			power_ = power;
 			while (power_ > 0 && l <= maxRadius)
 			{
 				if (power_ > 0)
 				{
-					ret = tilesAffected.insert(std::make_pair(dest, 0)); // check if we had this tile already affected
+					const int tileIndex = _save->getTileIndex(dest->getPosition());
+					const bool firstHit = _explosionGeneration[tileIndex] != _explosionCurrentGeneration; // check if we had this tile already affected
+					if (firstHit)
+					{
+						_explosionGeneration[tileIndex] = _explosionCurrentGeneration;
+						_explosionPower[tileIndex] = 0;
+						tilesAffected.push_back(tileIndex);
+					}
 
 					const int tileDmg = type->getTileFinalDamage(power_);
-					if (tileDmg > ret.first->second)
+					if (tileDmg > _explosionPower[tileIndex])
 					{
-						ret.first->second = tileDmg;
+						_explosionPower[tileIndex] = tileDmg;
 					}
-					if (ret.second)
+					if (firstHit)
 					{
 						const int damage = type->getRandomDamage(power_);
 						BattleUnit *bu = dest->getOverlappingUnit(_save);
@@ -3332,18 +3458,15 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 
 				l += 1.0;
 
-				tileX = int(floor(centetTile.x + 0.5 + l * sin_te * cos_fi));
-				tileY = int(floor(centetTile.y + 0.5 + l * cos_te * cos_fi));
-				tileZ = int(floor(centetTile.z + 0.5 + l * sin_fi));
+				// ray ends at the map edge or the explosion radius
+				if (step >= ray.size()) break;
 
 				origin = dest;
-				dest = _save->getTile(Position(tileX, tileY, tileZ));
-
-				if (!dest) break; // out of map!
+				dest = ray[step++];
 
 				// blockage by terrain is deducted from the explosion power
 				power_ -= type->RadiusReduction; // explosive damage decreases by 10 per tile
-				if (origin->getPosition().z != tileZ)
+				if (origin->getPosition().z != dest->getPosition().z)
 					power_ -= vertdec; //3d explosion factor
 
 				if (type->FireBlastCalc)
@@ -3387,14 +3510,17 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 	// now detonate the tiles affected by explosion
 	if (type->ToTile > 0.0f)
 	{
-		for (auto& pair : tilesAffected)
+		// same order as tiles are stored in map
+		std::sort(tilesAffected.begin(), tilesAffected.end());
+		for (int tileIndex : tilesAffected)
 		{
-			if (detonate(pair.first, pair.second))
+			Tile *tile = _save->getTile(tileIndex);
+			if (detonate(tile, _explosionPower[tileIndex]))
 			{
 				_save->addDestroyedObjective();
 			}
-			applyGravity(pair.first);
-			Tile *j = _save->getTile(pair.first->getPosition() + Position(0,0,1));
+			applyGravity(tile);
+			Tile *j = _save->getTile(tile->getPosition() + Position(0,0,1));
 			if (j)
 				applyGravity(j);
 		}
@@ -94,6 +94,14 @@ private:
 	std::vector<Uint32> _lightPropagationTerrainBlocking;
 	/// Cache for marking tiles that need light updated.
 	std::vector<Uint32> _lightPropagationTempNeedUpdate;
+	/// Highest power applied to tiles by current explosion.
+	std::vector<int> _explosionPower;
+	/// Explosion that last touched each tile, older values mean the power is stale.
+	std::vector<Uint32> _explosionGeneration;
+	/// Number of current explosion.
+	Uint32 _explosionCurrentGeneration = 0;
+	/// Buffer for units near the position of reaction fire check.
+	std::vector<BattleUnit*> _nearUnits;
 
 	const RuleInventory *_inventorySlotGround;
 	constexpr static int heightFromCenter[11] = {0,-2,+2,-4,+4,-6,+6,-8,+8,-12,+12};
@@ -151,7 +159,17 @@ private:
 	ReactionScore *getReactor(std::vector<ReactionScore> &spotters, BattleUnit *unit);
 	/// Tries to perform a reaction snap shot to this location.
 	bool tryReaction(ReactionScore *reaction, BattleUnit *target, const BattleAction &originalAction);
+
 public:
+	/// Part of line of fire check against a unit that does not depend on origin.
+	struct UnitTargetInfo
+	{
+		Position targetVoxel;
+		int targetMinHeight, targetMaxHeight, targetCenterHeight;
+		int heightRange, unitRadius, targetSize, xOffset, yOffset;
+		bool hypothetical;
+	};
+
 	/// Creates a new TileEngine class.
 	TileEngine(SavedBattleGame *save, Mod *mod);
 	/// Cleans up the TileEngine.
@@ -248,6 +266,10 @@ public:
 	int checkVoxelExposure(Position *originVoxel, Tile *tile, BattleUnit *excludeUnit, BattleUnit *excludeAllBut);
 	/// Checks validity for targetting a unit.
 	bool canTargetUnit(Position *originVoxel, Tile *tile, Position *scanVoxel, BattleUnit *excludeUnit, bool rememberObstacles, BattleUnit *potentialUnit = 0);
+	/// Prepares target data for line of fire checks against a unit.
+	bool getUnitTargetInfo(Tile *tile, BattleUnit *excludeUnit, BattleUnit *potentialUnit, UnitTargetInfo &info) const;
+	/// Checks line of fire from one origin using prepared target data.
+	bool canTargetUnitFrom(const Position &originVoxel, const UnitTargetInfo &info, Position *scanVoxel, BattleUnit *excludeUnit, bool rememberObstacles, std::vector<Position> &trajectory);
 	/// Check validity for targetting a tile.
 	bool canTargetTile(Position *originVoxel, Tile *tile, int part, Position *scanVoxel, BattleUnit *excludeUnit, bool rememberObstacles);
 	/// Calculates the z voxel for shadows.
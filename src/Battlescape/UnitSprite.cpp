@@ -26,6 +26,7 @@
 #include "../Savegame/SavedBattleGame.h"
 #include "../Mod/RuleInventory.h"
 #include "../Mod/Mod.h"
+#include "../Mod/ModScript.h"
 #include "../Engine/Exception.h"
 
 namespace OpenXcom
@@ -37,17 +38,18 @@ namespace OpenXcom
  * @param height Height in pixels.
  * @param x X position in pixels.
  * @param y Y position in pixels.
+ * @param cache Optional cache of composed unit sprites.
  */
-UnitSprite::UnitSprite(Surface* dest, const Mod* mod, const SavedBattleGame* save, int frame, bool helmet) :
+UnitSprite::UnitSprite(Surface* dest, const Mod* mod, const SavedBattleGame* save, int frame, bool helmet, UnitSpriteCache* cache) :
 	_unit(0), _itemR(0), _itemL(0),
 	_unitSurface(0),
 	_itemSurface(const_cast<Mod*>(mod)->getSurfaceSet("HANDOB.PCK")),
 	_fireSurface(const_cast<Mod*>(mod)->getSurfaceSet("SMOKE.PCK")),
 	_breathSurface(const_cast<Mod*>(mod)->getSurfaceSet("BREATH-1.PCK", false)),
 	_facingArrowSurface(const_cast<Mod*>(mod)->getSurfaceSet("DETBLOB.DAT")),
-	_dest(dest), _save(save), _mod(mod),
+	_dest(dest), _save(save), _mod(mod), _cache(cache),
 	_part(0), _animationFrame(frame), _drawingRoutine(0),
-	_helmet(helmet),
+	_helmet(helmet), _composing(false), _composeFailed(false),
 	_x(0), _y(0), _shade(0), _burn(0),
 	_mask(0, 0)
 {
@@ -133,13 +135,35 @@ void UnitSprite::selectUnit(Part& p, int index, int dir)
 	p.src = _unitSurface->getFrame(result);
 }
 
+/**
+ * Check if part fits in the cached sprite, parts that stick out
+ * too far are drawn directly instead.
+ * @param part part to draw.
+ * @return true if part can be drawn.
+ */
+bool UnitSprite::checkComposing(const Part& part)
+{
+	if (!_composing)
+	{
+		return true;
+	}
+	const int x = _x + part.offX;
+	const int y = _y + part.offY;
+	if (x < 0 || y < 0 || x + part.src->getWidth() > _dest->getWidth() || y + part.src->getHeight() > _dest->getHeight())
+	{
+		_composeFailed = true;
+		return false;
+	}
+	return true;
+}
+
 /**
  * Blit item sprite onto surface.
  * @param item item sprite, can be null.
  */
 void UnitSprite::blitItem(Part& item)
 {
-	if (!item.src)
+	if (!item.src || !checkComposing(item))
 	{
 		return;
 	}
@@ -159,7 +183,7 @@ void UnitSprite::blitItem(Part& item)
  */
 void UnitSprite::blitBody(Part& body)
 {
-	if (!body.src)
+	if (!body.src || !checkComposing(body))
 	{
 		return;
 	}
@@ -173,6 +197,136 @@ void UnitSprite::blitBody(Part& body)
 	_dest->unlock();
 }
 
+/**
+ * Check if the unit can be drawn from the cache. Custom scripts can use
+ * any state of the unit or the battle, only units with default
+ * scripts are cached.
+ * @return true if unit can use the cache.
+ */
+bool UnitSprite::isCacheable() const
+{
+	const auto* armor = _unit->getArmor();
+	if (!armor->getScript<ModScript::RecolorUnitSprite>().isDefault() || !armor->getScript<ModScript::SelectUnitSprite>().isDefault())
+	{
+		return false;
+	}
+	for (const auto* item : { _itemR, _itemL })
+	{
+		if (item)
+		{
+			const auto* rule = item->getRules();
+			if (!rule->getScript<ModScript::RecolorItemSprite>().isDefault() || !rule->getScript<ModScript::SelectItemSprite>().isDefault())
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * Draws the unit body from the cache, composing it again
+ * when anything that affects its look changed.
+ * @param routine drawing routine of the unit.
+ * @return false if unit needs to be drawn directly.
+ */
+bool UnitSprite::drawCached(void (UnitSprite::*routine)())
+{
+	if (!isCacheable())
+	{
+		return false;
+	}
+
+	// only these routines animate on their own
+	const bool animated =
+		routine == &UnitSprite::drawRoutine2 ||
+		routine == &UnitSprite::drawRoutine3 ||
+		routine == &UnitSprite::drawRoutine8 ||
+		routine == &UnitSprite::drawRoutine9 ||
+		routine == &UnitSprite::drawRoutine11 ||
+		routine == &UnitSprite::drawRoutine12 ||
+		routine == &UnitSprite::drawRoutine16 ||
+		routine == &UnitSprite::drawRoutine21;
+
+	UnitSpriteCache::Key key;
+	key.armor = _unit->getArmor();
+	const BattleItem *activeItem = _unit->getActiveHand(_itemL, _itemR);
+	key.ruleR = _itemR ? _itemR->getRules() : nullptr;
+	key.ruleL = _itemL ? _itemL->getRules() : nullptr;
+	key.idR = _itemR ? _itemR->getId() : -1;
+	key.idL = _itemL ? _itemL->getId() : -1;
+	key.activeId = activeItem ? activeItem->getId() : -1;
+	key.slotR = _itemR ? _itemR->getSlot() : nullptr;
+	key.slotL = _itemL ? _itemL->getSlot() : nullptr;
+	key.part = _part;
+	key.animationFrame = animated ? _animationFrame : 0;
+	key.shade = _shade;
+	key.burn = _burn;
+	key.status = _unit->getStatus();
+	key.direction = _unit->getDirection();
+	key.turretDirection = _unit->getTurretDirection();
+	key.turretType = _unit->getTurretType();
+	key.walkingPhase = _unit->getWalkingPhase();
+	key.fallingPhase = _unit->getFallingPhase();
+	key.gender = _unit->getGender();
+	key.movementType = _unit->getMovementType();
+	key.originalMovementType = _unit->getOriginalMovementType();
+	key.standHeight = _unit->getStandHeight();
+	key.floating = _unit->isFloating();
+	key.kneeled = _unit->isKneeled();
+	key.floorAbove = _unit->getFloorAbove();
+	key.helmet = _helmet;
+
+	auto& entry = _cache->_entries[_unit->getId() * 4 + _part];
+	if (!entry.valid || !(entry.key == key))
+	{
+		if (!entry.surface)
+		{
+			entry.surface = std::make_unique<Surface>(UnitSpriteCache::Width, UnitSpriteCache::Height);
+		}
+		entry.surface->clear();
+		entry.key = key;
+
+		Surface* dest = _dest;
+		const int x = _x, y = _y;
+		const GraphSubset mask = _mask;
+		_dest = entry.surface.get();
+		_x = UnitSpriteCache::Margin;
+		_y = UnitSpriteCache::Margin;
+		_mask = GraphSubset{ UnitSpriteCache::Width, UnitSpriteCache::Height };
+		_composing = true;
+		_composeFailed = false;
+		auto restore = [&]
+		{
+			_dest = dest;
+			_x = x;
+			_y = y;
+			_mask = mask;
+			_composing = false;
+		};
+		try
+		{
+			(this->*routine)();
+		}
+		catch (...)
+		{
+			entry.valid = false;
+			restore();
+			throw;
+		}
+		restore();
+
+		entry.valid = !_composeFailed;
+		if (!entry.valid)
+		{
+			return false;
+		}
+	}
+
+	entry.surface->blitNShade(_dest, _x - UnitSpriteCache::Margin, _y - UnitSpriteCache::Margin, 0, _mask);
+	return true;
+}
+
 /**
  * Draws a unit, using the drawing rules of the unit.
  * This function is called by Map, for each unit on the screen.
@@ -245,7 +399,11 @@ void UnitSprite::draw(const BattleUnit* unit, int part, int x, int y, int shade,
 		&UnitSprite::drawRoutine3,
 	};
 	// Call the matching routine
-	(this->*(routines[_drawingRoutine]))();
+	auto routine = routines[_drawingRoutine];
+	if (!_cache || !drawCached(routine))
+	{
+		(this->*routine)();
+	}
 	// draw fire
 	if (unit->getFire() > 0)
 	{
@@ -17,6 +17,9 @@
  * You should have received a copy of the GNU General Public License
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <memory>
+#include <tuple>
+#include <unordered_map>
 #include "../Engine/Surface.h"
 #include "../Engine/Script.h"
 
@@ -28,6 +31,54 @@ class BattleItem;
 class SavedBattleGame;
 class SurfaceSet;
 class Mod;
+class Armor;
+class RuleInventory;
+class RuleItem;
+
+/**
+ * Keeps the last composed body of every unit part, so units
+ * that did not change since the last frame are drawn with one blit.
+ */
+class UnitSpriteCache
+{
+	friend class UnitSprite;
+
+	/// Space around the sprite frame for arms and weapons sticking out.
+	static constexpr int Margin = 16;
+	static constexpr int Width = 32 + 2 * Margin;
+	static constexpr int Height = 40 + 2 * Margin;
+
+	/// Everything that selects and recolors the frames of a unit with default scripts.
+	/// Items are compared by rule and ID, memory of deleted items is reused by new ones.
+	struct Key
+	{
+		const Armor *armor;
+		const RuleItem *ruleR, *ruleL;
+		int idR, idL, activeId;
+		const RuleInventory *slotR, *slotL;
+		int part, animationFrame, shade, burn;
+		int status, direction, turretDirection, turretType, walkingPhase, fallingPhase;
+		int gender, movementType, originalMovementType, standHeight;
+		bool floating, kneeled, floorAbove, helmet;
+
+		auto tie() const
+		{
+			return std::tie(armor, ruleR, ruleL, idR, idL, activeId, slotR, slotL, part, animationFrame, shade, burn,
+				status, direction, turretDirection, turretType, walkingPhase, fallingPhase,
+				gender, movementType, originalMovementType, standHeight, floating, kneeled, floorAbove, helmet);
+		}
+		bool operator==(const Key &other) const { return tie() == other.tie(); }
+	};
+
+	struct Entry
+	{
+		Key key;
+		std::unique_ptr<Surface> surface;
+		bool valid = false;
+	};
+
+	std::unordered_map<int, Entry> _entries;
+};
 
 /**
  * A class that renders a specific unit, given its render rules
@@ -55,8 +106,9 @@ private:
 	Surface *_dest;
 	const SavedBattleGame *_save;
 	const Mod *_mod;
+	UnitSpriteCache *_cache;
 	int _part, _animationFrame, _drawingRoutine;
-	bool _helmet;
+	bool _helmet, _composing, _composeFailed;
 	int _x, _y, _shade, _burn;
 	GraphSubset _mask;
 
@@ -106,9 +158,15 @@ private:
 	void blitItem(Part& item);
 	/// Blit body sprite.
 	void blitBody(Part& body);
+	/// Check if part fits in the cached sprite.
+	bool checkComposing(const Part& part);
+	/// Check if the unit can be drawn from the cache.
+	bool isCacheable() const;
+	/// Draw the unit using the cache.
+	bool drawCached(void (UnitSprite::*routine)());
 public:
 	/// Creates a new UnitSprite at the specified position and size.
-	UnitSprite(Surface* dest, const Mod* mod, const SavedBattleGame* save, int frame, bool helmet);
+	UnitSprite(Surface* dest, const Mod* mod, const SavedBattleGame* save, int frame, bool helmet, UnitSpriteCache* cache = nullptr);
 	/// Cleans up the UnitSprite.
 	~UnitSprite();
 	/// Draws the unit.
@@ -79,6 +79,10 @@
 #include <cxxabi.h>
 #include <dlfcn.h>
 #include <dirent.h>
+#include <fcntl.h>
+#ifndef __MORPHOS__
+#include <sys/mman.h>
+#endif
 #include "Unicode.h"
 #endif		/* #ifdef _WIN32 */
 #include <SDL.h>
@@ -876,7 +880,8 @@ time_t getDateModified(const std::string &path)
 #ifdef _WIN32
 	time_t rv = 0;
 	auto pathW = pathToWindows(path);
-	auto fh = CreateFileW(pathW.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
+	// backup semantics are needed to open directories too
+	auto fh = CreateFileW(pathW.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, NULL);
 	if (fh == INVALID_HANDLE_VALUE) {
 		return 0;
 	}
@@ -899,6 +904,102 @@ time_t getDateModified(const std::string &path)
 #endif
 }
 
+/**
+ * Gets the size of a file.
+ * @param path Full path to file.
+ * @return The size in bytes, or -1 if the file can't be accessed.
+ */
+int64_t getFileSize(const std::string &path)
+{
+#ifdef _WIN32
+	int64_t rv = -1;
+	auto pathW = pathToWindows(path);
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (GetFileAttributesExW(pathW.c_str(), GetFileExInfoStandard, &data))
+	{
+		rv = ((int64_t)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+	}
+	return rv;
+#else
+	struct stat info;
+	if (stat(path.c_str(), &info) == 0)
+	{
+		return info.st_size;
+	}
+	else
+	{
+		return -1;
+	}
+#endif
+}
+
+/**
+ * Maps a whole file into memory, read-only.
+ * @param path Full path to file.
+ * @param size Returns the size of the file.
+ * @return Pointer to the file contents, or NULL if the file can't be mapped (eg. it's empty).
+ */
+const void *mapFile(const std::string &path, size_t *size)
+{
+#ifdef _WIN32
+	auto pathW = pathToWindows(path);
+	HANDLE file = CreateFileW(pathW.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return 0;
+	}
+	const void *data = 0;
+	LARGE_INTEGER fileSize;
+	if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 && (uint64_t)fileSize.QuadPart <= (uint64_t)SIZE_MAX)
+	{
+		HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping != NULL)
+		{
+			data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+			*size = (size_t)fileSize.QuadPart;
+		}
+	}
+	CloseHandle(file);
+	return data;
+#elif defined(__MORPHOS__)
+	return 0;
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return 0;
+	}
+	const void *data = 0;
+	struct stat info;
+	if (fstat(fd, &info) == 0 && info.st_size > 0)
+	{
+		void *view = mmap(0, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (view != MAP_FAILED)
+		{
+			data = view;
+			*size = (size_t)info.st_size;
+		}
+	}
+	close(fd);
+	return data;
+#endif
+}
+
+/**
+ * Releases a file mapped with mapFile.
+ * @param data Pointer to the file contents.
+ * @param size Size of the file.
+ */
+void unmapFile(const void *data, size_t size)
+{
+#ifdef _WIN32
+	UnmapViewOfFile(data);
+#elif !defined(__MORPHOS__)
+	munmap(const_cast<void*>(data), size);
+#endif
+}
+
 /**
  * Converts a date/time into a human-readable string
  * using the ISO 8601 standard.
@@ -944,9 +1045,12 @@ bool moveFile(const std::string &src, const std::string &dest)
 	auto dstW = pathToWindows(dest);
 	return (MoveFileExW(srcW.c_str(), dstW.c_str(), MOVEFILE_REPLACE_EXISTING) != 0);
 #else
-	// TODO In fact all remaining uses of this are renaming files inside a single directory
-	// so we may as well uncomment the rename() and drop the rest.
-	//return (rename(src.c_str(), dest.c_str()) == 0);
+	// rename() replaces the destination atomically, so a crash mid-save
+	// never leaves a truncated file; copying is only needed across filesystems
+	if (rename(src.c_str(), dest.c_str()) == 0)
+	{
+		return true;
+	}
 	std::ifstream srcStream;
 	std::ofstream destStream;
 	srcStream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
@@ -23,6 +23,7 @@
 #include <vector>
 #include <array>
 #include <memory>
+#include <cstdint>
 
 namespace OpenXcom
 {
@@ -83,6 +84,12 @@ namespace CrossPlatform
 	bool isQuitShortcut(const SDL_Event &ev);
 	/// Gets the modified date of a file.
 	time_t getDateModified(const std::string &path);
+	/// Gets the size of a file.
+	int64_t getFileSize(const std::string &path);
+	/// Maps a whole file into memory.
+	const void *mapFile(const std::string &path, size_t *size);
+	/// Releases a mapped file.
+	void unmapFile(const void *data, size_t size);
 	/// Converts a timestamp to a string.
 	std::pair<std::string, std::string> timeToString(time_t time);
 	/// Move/rename a file between paths.
@@ -36,11 +36,20 @@
  * A. somename.zip is always scanned before somename/ directory.
  */
 
+#include <algorithm>
+#include <cstring>
+#include <ctime>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <istream>
 #include <unordered_map>
 #include <unordered_set>
+#include <list>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
 
 #include "FileMap.h"
 #include "Unicode.h"
@@ -205,15 +214,241 @@ static inline std::string concatOptionalPaths(const std::string& basePath, const
 	}
 }
 
+/*
+ * I/O counters, see getIOStats().
+ */
+static std::atomic<uint64_t> StatBytesMapped(0);
+static std::atomic<uint64_t> StatBytesRead(0);
+static std::atomic<uint64_t> StatBytesInflated(0);
+static std::atomic<uint64_t> StatInflateMicros(0);
+static std::atomic<uint64_t> StatCacheHits(0);
+static std::atomic<uint64_t> StatCacheMisses(0);
+
+/**
+ * Wraps a file mapped into memory in RWops, without copying it.
+ * @param path Full path to the file.
+ * @return RWops that unmaps the file when closed, or NULL if the file can't be mapped.
+ */
+static SDL_RWops *mapFileRW(const std::string& path)
+{
+	size_t size = 0;
+	const void *data = CrossPlatform::mapFile(path, &size);
+	if (!data)
+	{
+		return NULL;
+	}
+	SDL_RWops *rv = SDL_RWFromConstMem(data, size);
+	if (!rv)
+	{
+		CrossPlatform::unmapFile(data, size);
+		return NULL;
+	}
+	rv->close = [](struct SDL_RWops *context)
+	{
+		if (context)
+		{
+			//HACK: `hidden` is an implementation detail, see `mzops_close`
+			if (context->hidden.mem.base)
+			{
+				CrossPlatform::unmapFile(context->hidden.mem.base, context->hidden.mem.stop - context->hidden.mem.base);
+			}
+			SDL_FreeRW(context);
+		}
+		return 0;
+	};
+	StatBytesMapped += size;
+	return rv;
+}
+
+/**
+ * Opens a file for reading, mapped into memory if possible.
+ * @param path Full path to the file.
+ * @return RWops for the file.
+ */
+static SDL_RWops *openFileRW(const std::string& path)
+{
+	SDL_RWops *rv = mapFileRW(path);
+	if (!rv)
+	{
+		rv = SDL_RWFromFile(path.c_str(), "rb");
+	}
+	return rv;
+}
+
+/*
+ * Cache of decompressed zip entries, so opening the same file again doesn't inflate it again.
+ * Entries are shared by all the RWops open on them and only freed once nobody uses them.
+ */
+struct InflatedEntry
+{
+	const void *zip;	// NULL once the zip is gone, then the entry is freed on the last close
+	size_t findex;
+	void *data;
+	size_t size;
+	int users;
+};
+static std::mutex InflateMutex;	// also guards the zip contexts, miniz readers aren't thread-safe
+static std::list<InflatedEntry> InflateCache;	// most recently used first
+static std::map<std::pair<const void *, size_t>, std::list<InflatedEntry>::iterator> InflateIndex;
+static std::unordered_map<const void *, std::list<InflatedEntry>::iterator> InflateUsers;
+static size_t InflateCacheBytes = 0;
+
+/**
+ * Frees the least recently used entries nobody is reading until the cache fits its budget.
+ * @param budget Size in bytes.
+ */
+static void trimInflateCache(size_t budget)
+{
+	for (auto i = InflateCache.end(); InflateCacheBytes > budget && i != InflateCache.begin();)
+	{
+		--i;
+		if (i->users == 0)
+		{
+			InflateCacheBytes -= i->size;
+			InflateIndex.erase(std::make_pair(i->zip, i->findex));
+			InflateUsers.erase(i->data);
+			mz_free(i->data);
+			i = InflateCache.erase(i);
+		}
+	}
+}
+
+/**
+ * Drops the whole cache, called when the zip contexts are closed.
+ * Entries still being read are freed when their last RWops is closed.
+ */
+static void clearInflateCache()
+{
+	std::lock_guard<std::mutex> lock(InflateMutex);
+	trimInflateCache(0);
+	for (auto& entry : InflateCache)
+	{
+		entry.zip = NULL;
+	}
+	InflateIndex.clear();
+}
+
+/**
+ * Releases an entry acquired with acquireZipEntry.
+ * @param data Decompressed data of the entry.
+ */
+static void releaseZipEntry(const void *data)
+{
+	std::lock_guard<std::mutex> lock(InflateMutex);
+	auto i = InflateUsers.find(data);
+	if (i == InflateUsers.end())
+	{
+		return;
+	}
+	auto entry = i->second;
+	entry->users -= 1;
+	if (entry->users == 0 && entry->zip == NULL)
+	{
+		InflateCacheBytes -= entry->size;
+		InflateUsers.erase(i);
+		mz_free(entry->data);
+		InflateCache.erase(entry);
+	}
+	else
+	{
+		trimInflateCache((size_t)std::max(Options::oxceZipCacheSize, 0) * 1024 * 1024);
+	}
+}
+
+/**
+ * Gets the decompressed contents of a zip entry, from the cache if possible.
+ * Has to be released with releaseZipEntry.
+ * @param zip Zip context.
+ * @param findex File index in the zip.
+ * @param size Returns the size of the data.
+ * @return Decompressed data, or NULL on error (see SDL_GetError).
+ */
+static const void *acquireZipEntry(mz_zip_archive *zip, size_t findex, size_t *size)
+{
+	std::lock_guard<std::mutex> lock(InflateMutex);
+	auto key = std::make_pair((const void *)zip, findex);
+	auto i = InflateIndex.find(key);
+	if (i != InflateIndex.end())
+	{
+		auto entry = i->second;
+		InflateCache.splice(InflateCache.begin(), InflateCache, entry);
+		entry->users += 1;
+		*size = entry->size;
+		StatCacheHits += 1;
+		return entry->data;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	size_t dataSize = 0;
+	void *data = mz_zip_reader_extract_to_heap(zip, (mz_uint)findex, &dataSize, 0);
+	if (data == NULL) {
+		SDL_SetError("miniz extract: %s", mz_zip_get_error_string(mz_zip_get_last_error(zip)));
+		return NULL;
+	}
+	StatInflateMicros += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+	StatBytesInflated += dataSize;
+	StatCacheMisses += 1;
+
+	InflateCache.push_front(InflatedEntry{ zip, findex, data, dataSize, 1 });
+	InflateCacheBytes += dataSize;
+	InflateIndex[key] = InflateCache.begin();
+	InflateUsers[data] = InflateCache.begin();
+	*size = dataSize;
+	return data;
+}
+
+/**
+ * Opens a zip entry as RWops over the cached decompressed data.
+ * @param zip Zip context.
+ * @param findex File index in the zip.
+ * @return RWops for the entry, or NULL on error.
+ */
+static SDL_RWops *openZipEntryRW(mz_zip_archive *zip, size_t findex)
+{
+	size_t size = 0;
+	const void *data = acquireZipEntry(zip, findex, &size);
+	if (data == NULL) {
+		return NULL;
+	}
+	SDL_RWops *rv = SDL_RWFromConstMem(data, size);
+	if (!rv) {
+		releaseZipEntry(data);
+		return NULL;
+	}
+	rv->close = [](struct SDL_RWops *context)
+	{
+		if (context)
+		{
+			//HACK: `hidden` is an implementation detail, see `mzops_close`
+			releaseZipEntry(context->hidden.mem.base);
+			SDL_FreeRW(context);
+		}
+		return 0;
+	};
+	return rv;
+}
+
+IOStats getIOStats()
+{
+	IOStats stats;
+	stats.bytesMapped = StatBytesMapped;
+	stats.bytesRead = StatBytesRead;
+	stats.bytesInflated = StatBytesInflated;
+	stats.inflateMicros = StatInflateMicros;
+	stats.cacheHits = StatCacheHits;
+	stats.cacheMisses = StatCacheMisses;
+	return stats;
+}
+
 FileRecord::FileRecord() : fullpath(""), zip(NULL), findex(0) { }
 
 SDL_RWops *FileRecord::getRWops() const
 {
 	SDL_RWops *rv;
 	if (zip != NULL) {
-		rv = SDL_RWFromMZ((mz_zip_archive *)zip, findex);
+		rv = openZipEntryRW((mz_zip_archive *)zip, findex);
 	} else {
-		rv = SDL_RWFromFile(fullpath.c_str(), "rb");
+		rv = openFileRW(fullpath);
 	}
 	if (!rv) { Log(LOG_ERROR) << "FileRecord::getRWops(): err=" << SDL_GetError(); }
 	return rv;
@@ -224,7 +459,11 @@ SDL_RWops *FileRecord::getRWopsReadAll() const
 	SDL_RWops *rv;
 	if (zip != NULL)
 	{
-		rv = SDL_RWFromMZ((mz_zip_archive *)zip, findex);
+		rv = openZipEntryRW((mz_zip_archive *)zip, findex);
+	}
+	else if ((rv = mapFileRW(fullpath)))
+	{
+		// already all in memory
 	}
 	else
 	{
@@ -235,6 +474,7 @@ SDL_RWops *FileRecord::getRWopsReadAll() const
 			auto data = SDL_LoadFile_RW(rv, &size, SDL_TRUE);
 			if (data)
 			{
+				StatBytesRead += size;
 				rv = SDL_RWFromConstMem(data, size);
 
 				//close callback
@@ -266,16 +506,16 @@ std::unique_ptr<std::istream> FileRecord::getIStream() const
 {
 	if (zip != NULL) {
 		size_t size;
-		void *data = mz_zip_reader_extract_to_heap((mz_zip_archive *)zip, findex, &size, 0);
+		const void *data = acquireZipEntry((mz_zip_archive *)zip, findex, &size);
 		if (data == NULL) {
 			auto err = "FileRecord::getIStream(): failed to decompress " + fullpath + ": ";
-			err += mz_zip_get_error_string(mz_zip_get_last_error((mz_zip_archive *)zip));
+			err += SDL_GetError();
 			Log(LOG_FATAL) << err;
 			throw Exception(err);
 		}
-		std::string a_string((char *)data, size);
+		std::string a_string((const char *)data, size);
 		auto rv = new std::stringstream(a_string);
-		mz_free(data);
+		releaseZipEntry(data);
 		return std::unique_ptr<std::istream>(rv);
 	} else {
 		return CrossPlatform::readFile(fullpath);
@@ -295,6 +535,20 @@ YAML::Node FileRecord::getYAML() const
 	}
 }
 
+uint64_t FileRecord::getStamp() const
+{
+	if (zip != NULL) {
+		std::lock_guard<std::mutex> lock(InflateMutex);
+		mz_zip_archive_file_stat stat;
+		if (!mz_zip_reader_file_stat((mz_zip_archive *)zip, findex, &stat)) {
+			return 0;
+		}
+		return ((uint64_t)stat.m_crc32 << 32) ^ stat.m_uncomp_size;
+	} else {
+		return ((uint64_t)CrossPlatform::getDateModified(fullpath) << 32) ^ (uint64_t)CrossPlatform::getFileSize(fullpath);
+	}
+}
+
 std::vector<YAML::Node> FileRecord::getAllYAML() const
 {
 	try
@@ -329,16 +583,17 @@ static std::string hexDumpBogusData(const std::string& bogus) {
 }
 /* recursively list a directory */
 typedef std::vector<std::pair<std::string, std::string>> dirlist_t; // <dirname, basename>
-static bool ls_r(const std::string &basePath, const std::string &relPath, dirlist_t& dlist) {
+static bool ls_r(const std::string &basePath, const std::string &relPath, dirlist_t& dlist, std::vector<std::string> *dirs = NULL) {
 	auto fullDir = concatOptionalPaths(basePath, relPath);
 	auto files = CrossPlatform::getFolderContents(fullDir);
+	if (dirs) { dirs->push_back(relPath); }
 	//Log(LOG_VERBOSE) << "ls_r: listing "<<fullDir<<" count="<<files.size();
 	for (auto i = files.begin(); i != files.end(); ++i) {
 		if (std::get<1>(*i)) { // it's a subfolder
 			auto fullpath = concatPaths(fullDir, std::get<0>(*i));
 			if (CrossPlatform::folderExists(fullpath)) {
 				auto nextRelPath = concatOptionalPaths(relPath, std::get<0>(*i));
-				ls_r(basePath, nextRelPath, dlist);
+				ls_r(basePath, nextRelPath, dlist, dirs);
 				continue;
 			}
 		} else {
@@ -347,6 +602,179 @@ static bool ls_r(const std::string &basePath, const std::string &relPath, dirlis
 	}
 	return true;
 }
+
+/*
+ * Persistent cache of directory listings, so big mod folders don't have to be walked on every startup.
+ * A listing is valid while the modification times of all its directories are unchanged,
+ * as adding, removing or renaming an entry updates the time of the directory containing it.
+ */
+struct DirListing {
+	std::vector<std::pair<std::string, time_t>> dirs; // relpath -> mtime, the top directory first
+	std::vector<std::pair<uint32_t, std::string>> files; // index in dirs -> basename, in ls_r order
+	bool used;
+};
+static const char DirCacheMagic[4] = { 'O', 'X', 'D', 'C' };
+static const uint32_t DirCacheVersion = 1;
+static std::unordered_map<std::string, DirListing> DirCache; // full path -> listing
+static bool DirCacheLoaded = false;
+static bool DirCacheChanged = false;
+
+static std::string getDirCachePath() { return Options::getUserFolder() + "modscan.cache"; }
+
+static void writeCacheInt(std::string &out, uint64_t v, int bytes) {
+	for (int i = 0; i < bytes; ++i) { out.push_back((char)((v >> (8 * i)) & 0xFF)); }
+}
+static void writeCacheString(std::string &out, const std::string &str) {
+	writeCacheInt(out, str.size(), 4);
+	out.append(str);
+}
+static bool readCacheInt(const char *&pos, const char *end, uint64_t &v, int bytes) {
+	if (end - pos < bytes) { return false; }
+	v = 0;
+	for (int i = 0; i < bytes; ++i) { v |= (uint64_t)(unsigned char)pos[i] << (8 * i); }
+	pos += bytes;
+	return true;
+}
+static bool readCacheString(const char *&pos, const char *end, std::string &str) {
+	uint64_t size;
+	if (!readCacheInt(pos, end, size, 4) || (uint64_t)(end - pos) < size) { return false; }
+	str.assign(pos, size);
+	pos += size;
+	return true;
+}
+
+/**
+ * Reads the directory cache from the user folder, once per run.
+ */
+static void loadDirCache() {
+	if (DirCacheLoaded) { return; }
+	DirCacheLoaded = true;
+	auto filename = getDirCachePath();
+	if (!Options::oxceModScanCache || Options::getRebuildModCache() || !CrossPlatform::fileExists(filename)) { return; }
+	size_t size = 0;
+	char *data = (char *)SDL_LoadFile_RW(SDL_RWFromFile(filename.c_str(), "rb"), &size, SDL_TRUE);
+	if (!data) { return; }
+	const char *pos = data, *end = data + size;
+	uint64_t version, count;
+	bool ok = size >= sizeof(DirCacheMagic) && memcmp(pos, DirCacheMagic, sizeof(DirCacheMagic)) == 0;
+	if (ok) { pos += sizeof(DirCacheMagic); }
+	ok = ok && readCacheInt(pos, end, version, 4) && version == DirCacheVersion && readCacheInt(pos, end, count, 4);
+	for (uint64_t i = 0; ok && i < count; ++i) {
+		std::string path;
+		DirListing listing;
+		uint64_t dircount, filecount, v;
+		ok = readCacheString(pos, end, path) && readCacheInt(pos, end, dircount, 4);
+		for (uint64_t j = 0; ok && j < dircount; ++j) {
+			std::string relpath;
+			ok = readCacheString(pos, end, relpath) && readCacheInt(pos, end, v, 8);
+			listing.dirs.push_back(std::make_pair(relpath, (time_t)v));
+		}
+		ok = ok && readCacheInt(pos, end, filecount, 4);
+		for (uint64_t j = 0; ok && j < filecount; ++j) {
+			std::string basename;
+			ok = readCacheInt(pos, end, v, 4) && v < dircount && readCacheString(pos, end, basename);
+			listing.files.push_back(std::make_pair((uint32_t)v, basename));
+		}
+		listing.used = false;
+		if (ok) { DirCache[path] = std::move(listing); }
+	}
+	SDL_free(data);
+	if (!ok) {
+		Log(LOG_WARNING) << "Ignoring corrupted mod scan cache " << filename;
+		DirCache.clear();
+	}
+}
+
+/**
+ * Writes the listings used in this run to the directory cache, if anything changed.
+ */
+void saveScanCache() {
+	if (!Options::oxceModScanCache) { return; }
+	for (const auto& i : DirCache) {
+		if (!i.second.used) { DirCacheChanged = true; } // drop listings of mods that are gone
+	}
+	if (!DirCacheChanged) { return; }
+	std::string out;
+	out.append(DirCacheMagic, sizeof(DirCacheMagic));
+	writeCacheInt(out, DirCacheVersion, 4);
+	size_t count = 0;
+	for (const auto& i : DirCache) { count += i.second.used; }
+	writeCacheInt(out, count, 4);
+	for (const auto& i : DirCache) {
+		if (!i.second.used) { continue; }
+		writeCacheString(out, i.first);
+		writeCacheInt(out, i.second.dirs.size(), 4);
+		for (const auto& dir : i.second.dirs) {
+			writeCacheString(out, dir.first);
+			writeCacheInt(out, (uint64_t)dir.second, 8);
+		}
+		writeCacheInt(out, i.second.files.size(), 4);
+		for (const auto& file : i.second.files) {
+			writeCacheInt(out, file.first, 4);
+			writeCacheString(out, file.second);
+		}
+	}
+	auto filename = getDirCachePath();
+	auto temp = filename + ".tmp";
+	if (!CrossPlatform::writeFile(temp, out) || !CrossPlatform::moveFile(temp, filename)) {
+		Log(LOG_WARNING) << "Failed to write mod scan cache " << filename;
+		return;
+	}
+	DirCacheChanged = false;
+}
+
+/**
+ * Recursively lists a directory, from the cache when its directories haven't changed.
+ * @param basePath - full path to the directory.
+ * @param dlist - receives the <dirname, basename> of every file.
+ */
+static void ls_r_cached(const std::string &basePath, dirlist_t& dlist) {
+	loadDirCache();
+	auto cached = DirCache.find(basePath);
+	if (cached != DirCache.end()) {
+		bool valid = true;
+		for (const auto& dir : cached->second.dirs) {
+			if (CrossPlatform::getDateModified(concatOptionalPaths(basePath, dir.first)) != dir.second) {
+				valid = false;
+				break;
+			}
+		}
+		if (valid) {
+			const auto& listing = cached->second;
+			dlist.reserve(dlist.size() + listing.files.size());
+			for (const auto& file : listing.files) {
+				dlist.push_back(std::make_pair(listing.dirs[file.first].first, file.second));
+			}
+			cached->second.used = true;
+			return;
+		}
+		DirCache.erase(cached);
+		DirCacheChanged = true;
+	}
+
+	std::vector<std::string> dirs;
+	size_t first = dlist.size();
+	ls_r(basePath, "", dlist, &dirs);
+	if (!Options::oxceModScanCache) { return; }
+
+	// directories changed in the last few seconds may still change within the same timestamp, don't trust them yet
+	time_t recent = time(0) - 2;
+	DirListing listing;
+	std::unordered_map<std::string, uint32_t> dirIndex;
+	for (const auto& dir : dirs) {
+		time_t mtime = CrossPlatform::getDateModified(concatOptionalPaths(basePath, dir));
+		if (mtime == 0 || mtime >= recent) { return; }
+		dirIndex[dir] = (uint32_t)listing.dirs.size();
+		listing.dirs.push_back(std::make_pair(dir, mtime));
+	}
+	listing.files.reserve(dlist.size() - first);
+	for (size_t i = first; i < dlist.size(); ++i) {
+		listing.files.push_back(std::make_pair(dirIndex[dlist[i].first], dlist[i].second));
+	}
+	listing.used = true;
+	DirCache[basePath] = std::move(listing);
+	DirCacheChanged = true;
+}
 static bool isRuleset(const std::string& fname) {
 	if (fname.size() < 4) { return false; }
 	auto last4 = fname.substr(fname.size() - 4);
@@ -418,7 +846,7 @@ struct VFSLayer {
 	*/
 	bool mapZipFile(const std::string& zippath, const std::string& prefix, bool ignore_ruls = false) {
 		std::string log_ctx = "mapZipFile(" + zippath + ",  '" + prefix + "',  '" + (ignore_ruls ? "true" : "false") + "'): ";
-		SDL_RWops *rwops = SDL_RWFromFile(zippath.c_str(), "r");
+		SDL_RWops *rwops = openFileRW(zippath);
 		if (!rwops) {
 			Log(LOG_WARNING) << log_ctx << "Ignoring zip '" << zippath << "': " << SDL_GetError();
 			return false;
@@ -502,9 +930,7 @@ struct VFSLayer {
 			throw Exception(err);
 		}
 		dirlist_t dlist;
-		if (!ls_r(dirpath, "", dlist)) {
-			return false;
-		}
+		ls_r_cached(dirpath, dlist);
 		fullpath = dirpath;
 		FileRecord frec;
 		frec.zip = NULL;
@@ -529,9 +955,13 @@ struct VFSLayer {
 		}
 	}
 };
+// stacks only reference the records and relpaths owned by their layers,
+// layers are immutable once mapped and live until FileMap::clear()
+typedef std::unordered_map<std::string_view, const FileRecord *> FileRefSet;
+
 struct VFSLayerStack {
 	std::vector<VFSLayer *> layers;
-	FileSet resources;
+	FileRefSet resources;
 	std::vector<FileRecord> rulesets;
 	std::unordered_map<std::string, NameSet> vdirs;
 
@@ -544,49 +974,41 @@ struct VFSLayerStack {
 		vdirs.clear();
 	}
 	void _merge_vdirs(VFSLayer *src) {
-		auto src_vdirs = src->vdirs;
-		for (auto i = src_vdirs.begin(); i != src_vdirs.end(); ++i) {
+		for (auto i = src->vdirs.begin(); i != src->vdirs.end(); ++i) {
 			auto vdi = vdirs.find(i->first);
 			if (vdi == vdirs.end()) {
 				vdirs.insert(*i);
 			} else {
-				for (auto ni = i->second.begin(); ni != i->second.end(); ++ni) {
-					vdi->second.insert(*ni);
-				}
+				vdi->second.insert(i->second.begin(), i->second.end());
 			}
 		}
 	}
 	void _merge_resources(VFSLayer *src, bool reverse) {
+		resources.reserve(resources.size() + src->resources.size());
 		for (auto ri = src->resources.begin(); ri != src->resources.end(); ++ri) {
-			auto crelpath = ri->first;
-			auto frec = ri->second;
-			auto existing = resources.find(crelpath);
-			if ((!reverse) && (existing != resources.end())) { resources.erase(existing); }
-			resources.insert(std::make_pair(crelpath, frec));
+			if (reverse) {
+				resources.emplace(ri->first, &ri->second); // keeps the existing record
+			} else {
+				resources.insert_or_assign(ri->first, &ri->second);
+			}
 		}
 	}
 	void push_back(VFSLayer *layer) {
 		layers.push_back(layer);
-		auto ruls = layer->rulesets;
-		for (auto i = ruls.begin(); i != ruls.end(); ++i) {
-			rulesets.push_back(*i);
-		}
+		rulesets.insert(rulesets.end(), layer->rulesets.begin(), layer->rulesets.end());
 		_merge_vdirs(layer);
 		_merge_resources(layer, false);
 	}
 	void push_front(VFSLayer *layer) {
 		layers.insert(layers.begin(), layer);
-		auto ruls = layer->rulesets;
-		for (auto i = ruls.rbegin(); i != ruls.rend(); ++i) {
-			rulesets.insert(rulesets.begin(), *i);
-		}
+		rulesets.insert(rulesets.begin(), layer->rulesets.begin(), layer->rulesets.end());
 		_merge_vdirs(layer);
 		_merge_resources(layer, true);
 	}
 	const FileRecord *at(const std::string& relpath) {
 		auto crelpath = canonicalize(relpath);
 		auto it = resources.find(crelpath);
-		return (it == resources.end()) ? NULL : &it->second;
+		return (it == resources.end()) ? NULL : it->second;
 	}
 	const NameSet& ls(const std::string& relpath) {
 		auto crelpath = canonicalize(relpath);
@@ -649,14 +1071,11 @@ struct VFS {
 	}
 	void push_back(ModRecord *mod) {
 		mods.push_back(mod);
-		auto layers = mod->stack.layers;
-		for (auto i = layers.begin(); i != layers.end(); ++i) {
-			stack.push_back(*i);
+		for (auto *layer : mod->stack.layers) {
+			stack.push_back(layer);
 		}
-		auto rulesets = mod->getRulesets();
-		auto modId = mod->modInfo.getId();
 		// 	typedef std::vector<std::pair<std::string, std::vector<FileRecord *>>> RSOrder;
-		rsorder.push_back(std::make_pair(modId, rulesets));
+		rsorder.push_back(std::make_pair(mod->modInfo.getId(), mod->getRulesets()));
 	}
 	void map_common(bool embeddedOnly) {
 		auto mrec = new ModRecord("common");
@@ -712,6 +1131,7 @@ void clear(bool clearOnly, bool embeddedOnly) {
 	ModsAvailable.clear();
 	for (auto i : MappedVFSLayers ) { delete i; }
 	MappedVFSLayers.clear();
+	clearInflateCache();
 	for (auto i : ZipContexts) { mz_zip_reader_end_rwops(i); SDL_free(i); }
 	ZipContexts.clear();
 	if (!clearOnly)
@@ -935,7 +1355,7 @@ void scanModZipRW(SDL_RWops *rwops, const std::string& fullpath) {
  */
 void scanModZip(const std::string& fullpath) {
 	std::string log_ctx = "scanModZip(" + fullpath + "): ";
-	SDL_RWops *rwops = SDL_RWFromFile(fullpath.c_str(), "r");
+	SDL_RWops *rwops = openFileRW(fullpath);
 	if (!rwops) {
 		Log(LOG_WARNING) << log_ctx << "Ignoring zip: " << SDL_GetError();
 		return;
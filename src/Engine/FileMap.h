@@ -22,6 +22,7 @@
 #include <string>
 #include <vector>
 #include <istream>
+#include <cstdint>
 #include <unordered_set>
 #include <yaml-cpp/yaml.h>
 #include <SDL_rwops.h>
@@ -51,9 +52,24 @@ namespace FileMap
 
 		std::unique_ptr<std::istream> getIStream() const;
 		YAML::Node getYAML() const;
+		/// Gets a value that changes whenever the file contents change.
+		uint64_t getStamp() const;
 		std::vector<YAML::Node> getAllYAML() const;
 	};
 
+	/// Counters of the data read through the VFS.
+	struct IOStats {
+		uint64_t bytesMapped;	// loose files mapped into memory
+		uint64_t bytesRead;		// loose files copied into memory
+		uint64_t bytesInflated;	// zip entries decompressed
+		uint64_t inflateMicros;	// time spent decompressing
+		uint64_t cacheHits;		// zip entries opened again without decompressing
+		uint64_t cacheMisses;
+	};
+
+	/// Gets the I/O counters since startup.
+	IOStats getIOStats();
+
 	/// For common operations on bunches of filenames
 	typedef std::unordered_set<std::string> NameSet;
 
@@ -110,6 +126,9 @@ namespace FileMap
 	/// scans a moddir for mods, (privately) maps them.
 	void scanModDir(const std::string& dirname, const std::string& basename, bool protectedLocation);
 
+	/// saves the listings of mapped directories, so the next scan can skip unchanged ones.
+	void saveScanCache();
+
 	/// scans a .zip from the rwops for mods
 	void scanModZipRW(SDL_RWops *rwops, const std::string& fullpath);
 
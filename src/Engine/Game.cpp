@@ -30,14 +30,17 @@
 #include "Logger.h"
 #include "../Interface/Cursor.h"
 #include "../Interface/FpsCounter.h"
+#include "../Interface/SaveIndicator.h"
 #include "../Mod/Mod.h"
 #include "../Savegame/SavedGame.h"
 #include "../Savegame/SavedBattleGame.h"
+#include "../Savegame/AsyncSave.h"
 #include "Action.h"
 #include "Exception.h"
 #include "Options.h"
 #include "CrossPlatform.h"
 #include "FileMap.h"
+#include "ScriptProfiler.h"
 #include "Unicode.h"
 #include "../Ufopaedia/UfopaediaStartState.h"
 #include "../Menu/NotesState.h"
@@ -100,6 +103,9 @@ Game::Game(const std::string &title) : _screen(0), _cursor(0), _lang(0), _save(0
 	// Create fps counter
 	_fpsCounter = new FpsCounter(15, 5, 0, 0);
 
+	// Create background save indicator
+	_saveIndicator = new SaveIndicator(5, 5, 0, 1);
+
 	// Create blank language
 	_lang = new Language();
 
@@ -114,6 +120,11 @@ Game::~Game()
 	Sound::stop();
 	Music::stop();
 
+	if (Options::oxceScriptProfiler)
+	{
+		ScriptProfiler::report();
+	}
+
 	for (auto* state : _states)
 	{
 		delete state;
@@ -127,6 +138,7 @@ Game::~Game()
 	delete _mod;
 	delete _screen;
 	delete _fpsCounter;
+	delete _saveIndicator;
 
 	Mix_CloseAudio();
 
@@ -302,6 +314,11 @@ void Game::run()
 								}
 							}
 						}
+						// "ctrl-alt-p" script profile
+						else if (action.getDetails()->key.keysym.sym == SDLK_p && isCtrlPressed() && isAltPressed() && Options::oxceScriptProfiler)
+						{
+							ScriptProfiler::report();
+						}
 						else if (Options::debug)
 						{
 							if (action.getDetails()->key.keysym.sym == SDLK_t && isCtrlPressed())
@@ -333,6 +350,8 @@ void Game::run()
 			// Process logic
 			_states.back()->think();
 			_fpsCounter->think();
+			_saveIndicator->think();
+			AsyncSave::think();
 			if (Options::FPS > 0 && !(Options::useOpenGL && Options::vSyncForOpenGL))
 			{
 				// Update our FPS delay time based on the time of the last draw.
@@ -363,6 +382,8 @@ void Game::run()
 					(*i)->blit();
 				}
 				_fpsCounter->blit(_screen->getSurface());
+				_saveIndicator->setX(_screen->getSurface()->w - _saveIndicator->getWidth() - 1);
+				_saveIndicator->blit(_screen->getSurface());
 				_cursor->blit(_screen->getSurface());
 				_screen->flip();
 			}
@@ -379,6 +400,8 @@ void Game::run()
 		}
 	}
 
+	// Make sure a background save is on disk before leaving
+	AsyncSave::flush();
 	Options::save();
 }
 
@@ -494,13 +517,33 @@ void Game::setSavedGame(SavedGame *save)
 
 /**
  * Loads the mods specified in the game options.
+ * If loading from the ruleset cache fails, the rulesets are
+ * parsed again so the error is reported with its line number.
  */
 void Game::loadMods()
 {
 	Mod::resetGlobalStatics();
 	delete _mod;
 	_mod = new Mod();
-	_mod->loadAll();
+	try
+	{
+		_mod->loadAll();
+	}
+	catch (std::exception &e)
+	{
+		if (!_mod->isRulesetCacheUsed())
+		{
+			throw;
+		}
+		// cached documents have no marks, load again from the files so the error has line numbers
+		Log(LOG_WARNING) << "Loading mods from the ruleset cache failed: " << e.what();
+		Log(LOG_INFO) << "Parsing rulesets again to locate the error...";
+		Options::requestRebuildModCache();
+		Mod::resetGlobalStatics();
+		delete _mod;
+		_mod = new Mod();
+		_mod->loadAll();
+	}
 }
 
 /**
@@ -32,6 +32,7 @@ class SavedGame;
 class Mod;
 class ModInfo;
 class FpsCounter;
+class SaveIndicator;
 class Action;
 
 /**
@@ -52,6 +53,7 @@ private:
 	Mod *_mod;
 	bool _quit, _init, _update;
 	FpsCounter *_fpsCounter;
+	SaveIndicator *_saveIndicator;
 	bool _mouseActive;
 	unsigned int _timeOfLastFrame;
 	int _timeUntilNextFrame;
@@ -77,6 +79,8 @@ public:
 	Cursor *getCursor() const { return _cursor; }
 	/// Gets the FpsCounter.
 	FpsCounter *getFpsCounter() const { return _fpsCounter; }
+	/// Gets the background save indicator.
+	SaveIndicator *getSaveIndicator() const { return _saveIndicator; }
 	/// Resets the state stack to a new state.
 	void setState(State *state);
 	/// Pushes a new state into the state stack.
@@ -0,0 +1,90 @@
+#pragma once
+/*
+ * Copyright 2010-2023 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace OpenXcom
+{
+
+/**
+ * Allocator of memory for objects of one type.
+ * Memory is taken from the system in big chunks and freed blocks are reused by next allocations,
+ * chunks are kept until the pool is destroyed, so objects created and deleted
+ * during a battle do not fragment the heap.
+ * Not thread safe.
+ */
+template<typename T, std::size_t ChunkSize = 256>
+class ObjectPool
+{
+	/// Memory of one object, or link to next free block.
+	union Block
+	{
+		Block* next;
+		alignas(T) unsigned char data[sizeof(T)];
+	};
+
+	std::vector<std::unique_ptr<Block[]>> _chunks;
+	Block* _free = nullptr;
+
+public:
+	/// Default constructor.
+	ObjectPool() = default;
+	/// Pool is bound to its memory.
+	ObjectPool(const ObjectPool&) = delete;
+	/// Pool is bound to its memory.
+	ObjectPool& operator=(const ObjectPool&) = delete;
+
+	/**
+	 * Gets uninitialized memory for one object.
+	 */
+	void* allocate()
+	{
+		if (_free == nullptr)
+		{
+			auto chunk = std::make_unique<Block[]>(ChunkSize);
+			for (std::size_t i = 0; i < ChunkSize; ++i)
+			{
+				chunk[i].next = _free;
+				_free = &chunk[i];
+			}
+			_chunks.push_back(std::move(chunk));
+		}
+		Block* block = _free;
+		_free = block->next;
+		return block;
+	}
+
+	/**
+	 * Returns memory of destroyed object to pool.
+	 */
+	void deallocate(void* p)
+	{
+		if (p == nullptr)
+		{
+			return;
+		}
+		Block* block = static_cast<Block*>(p);
+		block->next = _free;
+		_free = block;
+	}
+};
+
+} //namespace OpenXcom
@@ -56,6 +56,7 @@ std::string _masterMod;
 int _passwordCheck = -1;
 bool _loadLastSave = false;
 bool _loadLastSaveExpended = false;
+bool _rebuildModCache = false;
 
 /**
  * Sets up the options by creating their OptionInfo metadata.
@@ -254,6 +255,17 @@ void create()
 	_info.push_back(OptionInfo("oxceRawScreenShots", &oxceRawScreenShots, false));
 	_info.push_back(OptionInfo("oxceFirstPersonViewFisheyeProjection", &oxceFirstPersonViewFisheyeProjection, false));
 	_info.push_back(OptionInfo("oxceThumbButtons", &oxceThumbButtons, true));
+	_info.push_back(OptionInfo("oxceBinarySaves", &oxceBinarySaves, false));
+	_info.push_back(OptionInfo("oxceBinarySaveCompression", &oxceBinarySaveCompression, 1));
+	_info.push_back(OptionInfo("oxceAsyncSaves", &oxceAsyncSaves, true));
+	_info.push_back(OptionInfo("oxceWorkerThreads", &oxceWorkerThreads, 0));
+	_info.push_back(OptionInfo("oxceRulesetCache", &oxceRulesetCache, true));
+	_info.push_back(OptionInfo("oxceSurfaceCacheSize", &oxceSurfaceCacheSize, 32));
+	_info.push_back(OptionInfo("oxceZipCacheSize", &oxceZipCacheSize, 32));
+	_info.push_back(OptionInfo("oxceModScanCache", &oxceModScanCache, true));
+	_info.push_back(OptionInfo("oxceScriptProfiler", &oxceScriptProfiler, false));
+	_info.push_back(OptionInfo("oxceScriptOptimize", &oxceScriptOptimize, true));
+	_info.push_back(OptionInfo("oxceBattleRecorder", &oxceBattleRecorder, false));
 
 	_info.push_back(OptionInfo("oxceRecommendedOptionsWereSet", &oxceRecommendedOptionsWereSet, false));
 	_info.push_back(OptionInfo("password", &password, "secret"));
@@ -506,6 +518,11 @@ static void loadArgs()
 				_loadLastSave = true;
 				continue;
 			}
+			if (argname == "rebuild-mod-cache")
+			{
+				_rebuildModCache = true;
+				continue;
+			}
 			if (argv.size() > i + 1)
 			{
 				++i; // we'll be consuming the next argument too
@@ -567,6 +584,8 @@ static bool showHelp()
 	help << "        use PATH as the default Config Folder instead of auto-detecting" << std::endl << std::endl;
 	help << "-master MOD" << std::endl;
 	help << "        set MOD to the current master mod (eg. -master xcom2)" << std::endl << std::endl;
+	help << "-rebuild-mod-cache" << std::endl;
+	help << "        ignore the ruleset cache and parse all mod rulesets again" << std::endl << std::endl;
 	help << "-KEY VALUE" << std::endl;
 	help << "        override option KEY with VALUE (eg. -displayWidth 640)" << std::endl << std::endl;
 	help << "-help" << std::endl;
@@ -705,6 +724,7 @@ void refreshMods()
 		FileMap::scanModDir(getDataFolder(), "mods", false);
 	}
 #endif
+	FileMap::saveScanCache();
 
 	// Check mods' dependencies on other mods and extResources (UFO, TFTD, etc),
 	// also breaks circular dependency loops.
@@ -936,6 +956,21 @@ void expendLoadLastSave()
 	_loadLastSaveExpended = true;
 }
 
+bool getRebuildModCache()
+{
+	return _rebuildModCache;
+}
+
+void expendRebuildModCache()
+{
+	_rebuildModCache = false;
+}
+
+void requestRebuildModCache()
+{
+	_rebuildModCache = true;
+}
+
 /**
  * Sets up the game's Data folder where the data files
  * are loaded from and the User folder and Config
@@ -122,6 +122,12 @@ namespace Options
 	bool getLoadLastSave();
 	/// And do it only at startup
 	void expendLoadLastSave();
+	/// If we should ignore the ruleset cache
+	bool getRebuildModCache();
+	/// And do it only at startup
+	void expendRebuildModCache();
+	/// Ignore the ruleset cache on the next mod load
+	void requestRebuildModCache();
 }
 
 }
@@ -106,6 +106,50 @@ OPT bool oxceListVFSContents;
 OPT bool oxceRawScreenShots;
 OPT bool oxceFirstPersonViewFisheyeProjection;
 OPT bool oxceThumbButtons;
+/**
+ * Write saves as a sectioned binary container instead of plain YAML.
+ * Compression level of the sections, 0 stores them uncompressed.
+ */
+OPT bool oxceBinarySaves;
+OPT int oxceBinarySaveCompression;
+/**
+ * Write autosaves and ironman saves on a background thread.
+ */
+OPT bool oxceAsyncSaves;
+/**
+ * Number of worker threads used while loading, 0 means one per hardware thread.
+ */
+OPT int oxceWorkerThreads;
+/**
+ * Keep parsed mod rulesets in a cache in the user folder.
+ */
+OPT bool oxceRulesetCache;
+/**
+ * Memory in MB kept for lazily loaded images that can be evicted and read again, like Ufopaedia pictures.
+ * 0 keeps everything loaded. Only used with lazy loading.
+ */
+OPT int oxceSurfaceCacheSize;
+/**
+ * Memory in MB kept for decompressed files from zipped mods, so opening them again is fast. 0 disables the cache.
+ */
+OPT int oxceZipCacheSize;
+/**
+ * Keep the file lists of mod folders in a cache in the user folder, and only scan the folders that changed.
+ */
+OPT bool oxceModScanCache;
+/**
+ * Measure how long every mod script runs, the report is written to the log on exit or with Ctrl-Alt-P.
+ */
+OPT bool oxceScriptProfiler;
+/**
+ * Fuse common pairs of script operations after compiling, only turned off to compare script speed.
+ */
+OPT bool oxceScriptOptimize;
+/**
+ * Record battle states, RNG seeds and state hashes at turn boundaries to `battle_record_<mission>_stage<N>.txt`, with time spent in each battle state type.
+ * A rerun of a recorded battle is checked against the previous record and the first difference is logged.
+ */
+OPT bool oxceBattleRecorder;
 
 OPT bool oxceRecommendedOptionsWereSet;
 OPT std::string password;
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2010-2023 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+#include <SDL_thread.h>
+#include "Options.h"
+
+namespace OpenXcom
+{
+
+namespace Parallel
+{
+
+namespace
+{
+
+/**
+ * Work shared by all the threads of one forEach call.
+ */
+struct ParallelJob
+{
+	const std::function<void(size_t)> *func;
+	size_t count;
+	std::atomic<size_t> next;
+	std::atomic<bool> failed;
+	std::exception_ptr error;
+};
+
+/**
+ * Takes indexes off the job until there's none left.
+ * The first exception stops the remaining work and is kept for the caller.
+ * @param data Pointer to the job.
+ * @return 0.
+ */
+int runJob(void *data)
+{
+	ParallelJob *job = (ParallelJob*)data;
+	size_t i;
+	while (!job->failed && (i = job->next++) < job->count)
+	{
+		try
+		{
+			(*job->func)(i);
+		}
+		catch (...)
+		{
+			if (!job->failed.exchange(true))
+			{
+				job->error = std::current_exception();
+			}
+		}
+	}
+	return 0;
+}
+
+}
+
+/**
+ * Gets how many worker threads to use, either from the
+ * user options or from the number of hardware threads.
+ * @return Number of threads, at least 1.
+ */
+int getThreadCount()
+{
+	int threads = Options::oxceWorkerThreads;
+	if (threads <= 0)
+	{
+		threads = (int)std::thread::hardware_concurrency();
+	}
+	return threads > 0 ? threads : 1;
+}
+
+/**
+ * Runs a function for every index from 0 to count - 1.
+ * The calling thread works too and only returns when all indexes
+ * are done. Order of the calls is not defined.
+ * @param count Number of indexes.
+ * @param func Function to call with each index.
+ * @throws The first exception thrown by the function.
+ */
+void forEach(size_t count, const std::function<void(size_t)> &func)
+{
+	ParallelJob job;
+	job.func = &func;
+	job.count = count;
+	job.next = 0;
+	job.failed = false;
+
+	std::vector<SDL_Thread*> threads;
+	size_t extra = std::min((size_t)getThreadCount(), count) - (count > 0 ? 1 : 0);
+	for (size_t t = 0; t < extra; ++t)
+	{
+		SDL_Thread *thread = SDL_CreateThread(runJob, (void*)&job);
+		if (thread == 0)
+		{
+			// fewer threads is fine, this one still does the work
+			break;
+		}
+		threads.push_back(thread);
+	}
+	runJob((void*)&job);
+	for (auto* thread : threads)
+	{
+		SDL_WaitThread(thread, 0);
+	}
+
+	if (job.error)
+	{
+		std::rethrow_exception(job.error);
+	}
+}
+
+}
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+/*
+ * Copyright 2010-2023 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <functional>
+
+namespace OpenXcom
+{
+
+/**
+ * Helpers for spreading independent work over worker threads.
+ * The work items must not touch shared state or log anything.
+ */
+namespace Parallel
+{
+	/// Gets how many worker threads to use.
+	int getThreadCount();
+	/// Runs a function for every index, spread over worker threads.
+	void forEach(size_t count, const std::function<void(size_t)> &func);
+}
+
+}
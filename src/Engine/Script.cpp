@@ -24,11 +24,13 @@
 #include <cmath>
 #include <bitset>
 #include <array>
+#include <chrono>
 
 #include "Logger.h"
 #include "Options.h"
 #include "Script.h"
 #include "ScriptBind.h"
+#include "ScriptProfiler.h"
 #include "Surface.h"
 #include "ShaderDraw.h"
 #include "ShaderMove.h"
@@ -65,6 +67,27 @@ namespace OpenXcom
 	MACRO_COPY_64(Func, (Pos) + 0x80) \
 	MACRO_COPY_64(Func, (Pos) + 0xC0)
 
+/**
+ * Same as MACRO_COPY_256 but position is single token (like `0x4F`), it can be used to build names.
+ */
+#define MACRO_TOKEN_COPY_16(Func, Hi) \
+	Func(Hi##0) Func(Hi##1) Func(Hi##2) Func(Hi##3) \
+	Func(Hi##4) Func(Hi##5) Func(Hi##6) Func(Hi##7) \
+	Func(Hi##8) Func(Hi##9) Func(Hi##A) Func(Hi##B) \
+	Func(Hi##C) Func(Hi##D) Func(Hi##E) Func(Hi##F)
+#define MACRO_TOKEN_COPY_256(Func) \
+	MACRO_TOKEN_COPY_16(Func, 0x0) MACRO_TOKEN_COPY_16(Func, 0x1) MACRO_TOKEN_COPY_16(Func, 0x2) MACRO_TOKEN_COPY_16(Func, 0x3) \
+	MACRO_TOKEN_COPY_16(Func, 0x4) MACRO_TOKEN_COPY_16(Func, 0x5) MACRO_TOKEN_COPY_16(Func, 0x6) MACRO_TOKEN_COPY_16(Func, 0x7) \
+	MACRO_TOKEN_COPY_16(Func, 0x8) MACRO_TOKEN_COPY_16(Func, 0x9) MACRO_TOKEN_COPY_16(Func, 0xA) MACRO_TOKEN_COPY_16(Func, 0xB) \
+	MACRO_TOKEN_COPY_16(Func, 0xC) MACRO_TOKEN_COPY_16(Func, 0xD) MACRO_TOKEN_COPY_16(Func, 0xE) MACRO_TOKEN_COPY_16(Func, 0xF)
+
+/**
+ * Compilers that support "labels as values" can dispatch script operations with computed goto.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define SCRIPT_THREADED_DISPATCH
+#endif
+
 
 ////////////////////////////////////////////////////////////
 //						proc definition
@@ -347,8 +370,65 @@ struct Func_test_eq_text
 	}
 };
 
+/**
+ * Two operations executed as one, to save dispatch between them.
+ * First operation can't change program position.
+ */
+template<typename First, typename Second>
+struct FuncFused
+{
+	static constexpr int offset = First::offset + 1 + Second::offset;
+
+	[[gnu::always_inline]]
+	static RetEnum func(ScriptWorkerBase& sw, const Uint8* procArgs, ProgPos& curr)
+	{
+		const auto ret = First::func(sw, procArgs, curr);
+		if (ret != RetContinue)
+		{
+			return ret;
+		}
+		return Second::func(sw, procArgs + First::offset + 1, curr);
+	}
+};
+
+template<typename First, typename Second, int VerSecond, int... VerFirst>
+using FuncFusedRow = helper::SumList<FuncFused<helper::GetType<typename helper::FuncGroup<First>::FuncList, VerFirst>, helper::GetType<typename helper::FuncGroup<Second>::FuncList, VerSecond>>...>;
+
+template<typename First, typename Second, typename VerFirst = helper::MakeListTag<helper::FuncGroup<First>::ver()>, typename VerSecond = helper::MakeListTag<helper::FuncGroup<Second>::ver()>>
+struct FuncFusedGroup;
+
+/**
+ * All versions of two fused operations, version is `verSecond * verFirstCount + verFirst`.
+ */
+template<typename First, typename Second, int... VerFirst, int... VerSecond>
+struct FuncFusedGroup<First, Second, helper::ListTag<VerFirst...>, helper::ListTag<VerSecond...>>
+{
+	using FuncList = decltype((helper::SumList<>{} + ... + FuncFusedRow<First, Second, VerSecond, VerFirst...>{}));
+
+	static constexpr int ver()
+	{
+		return sizeof...(VerFirst) * sizeof...(VerSecond);
+	}
+};
+
 } //namespace
 
+/**
+ * Pairs of operations that often follow each other in scripts (based on default and common mod scripts),
+ * after parsing they are replaced by one operation that executes both.
+ * @param IMPL macro function that take 2 args: names of first and second operation.
+ */
+#define MACRO_FUSED_DEFINITION(IMPL) \
+	IMPL(set,			exit) \
+	IMPL(set,			test_eq) \
+	IMPL(set,			test_le) \
+	IMPL(add,			set) \
+	IMPL(add,			limit) \
+	IMPL(add_shade,		set) \
+	IMPL(get_color,		test_eq) \
+	IMPL(get_shade,		test_le) \
+
+
 ////////////////////////////////////////////////////////////
 //					Proc_Enum definition
 ////////////////////////////////////////////////////////////
@@ -365,17 +445,69 @@ struct Func_test_eq_text
 	MACRO_PROC_ID(NAME), \
 	Proc_##NAME##_end = MACRO_PROC_ID(NAME) + helper::FuncGroup<MACRO_FUNC_ID(NAME)>::ver() - 1,
 
+/**
+ * Macro returning enum of fused operations
+ */
+#define MACRO_FUSED_ID(first, second) Proc_##first##__##second
+
+/**
+ * Macro used for creating ProcEnum from MACRO_FUSED_DEFINITION
+ */
+#define MACRO_CREATE_FUSED_ENUM(FIRST, SECOND) \
+	MACRO_FUSED_ID(FIRST, SECOND), \
+	Proc_##FIRST##__##SECOND##_end = MACRO_FUSED_ID(FIRST, SECOND) + FuncFusedGroup<MACRO_FUNC_ID(FIRST), MACRO_FUNC_ID(SECOND)>::ver() - 1,
+
 /**
  * Enum storing id of all available operations in script engine
  */
 enum ProcEnum : Uint8
 {
 	MACRO_PROC_DEFINITION(MACRO_CREATE_PROC_ENUM)
+	Proc_BaseMax,
+	Proc_FusedBegin = Proc_BaseMax - 1,
+	MACRO_FUSED_DEFINITION(MACRO_CREATE_FUSED_ENUM)
 	Proc_EnumMax,
 };
 
+#undef MACRO_CREATE_FUSED_ENUM
 #undef MACRO_CREATE_PROC_ENUM
 
+/**
+ * List of implementations of all operations, index is ProcEnum.
+ */
+#define MACRO_FUNC_ARRAY(NAME, ...) + helper::FuncGroup<MACRO_FUNC_ID(NAME)>::FuncList{}
+#define MACRO_FUSED_ARRAY(FIRST, SECOND) + FuncFusedGroup<MACRO_FUNC_ID(FIRST), MACRO_FUNC_ID(SECOND)>::FuncList{}
+using ProcFuncList = decltype(MACRO_PROC_DEFINITION(MACRO_FUNC_ARRAY) MACRO_FUSED_DEFINITION(MACRO_FUSED_ARRAY));
+#undef MACRO_FUSED_ARRAY
+#undef MACRO_FUNC_ARRAY
+
+static_assert(ProcFuncList::size == Proc_EnumMax, "Function list do not match operation enum");
+
+/**
+ * Size of arguments of each operation.
+ */
+#define MACRO_PROC_SIZE(POS) helper::GetType<ProcFuncList, POS>::offset,
+constexpr int ProcArgSize[256] = { MACRO_COPY_256(MACRO_PROC_SIZE, 0) };
+#undef MACRO_PROC_SIZE
+
+/**
+ * Gets fused operation that replaces two operations.
+ * @return Fused operation id or 0 if they can't be fused.
+ */
+static Uint8 getFusedProc(Uint8 first, Uint8 second)
+{
+	#define MACRO_FUSED_MATCH(FIRST, SECOND) \
+		if (MACRO_PROC_ID(FIRST) <= first && first <= Proc_##FIRST##_end && MACRO_PROC_ID(SECOND) <= second && second <= Proc_##SECOND##_end) \
+		{ \
+			return MACRO_FUSED_ID(FIRST, SECOND) + (second - MACRO_PROC_ID(SECOND)) * (Proc_##FIRST##_end - MACRO_PROC_ID(FIRST) + 1) + (first - MACRO_PROC_ID(FIRST)); \
+		}
+
+	MACRO_FUSED_DEFINITION(MACRO_FUSED_MATCH)
+
+	#undef MACRO_FUSED_MATCH
+	return 0;
+}
+
 ////////////////////////////////////////////////////////////
 //					core loop function
 ////////////////////////////////////////////////////////////
@@ -383,19 +515,20 @@ enum ProcEnum : Uint8
 /**
  * Core function in script engine used to executing scripts
  * @param proc array storing operation of script
+ * @param ops counter of executed operations, only used when profiling
  * @return Result of executing script
  */
-static inline void scriptExe(ScriptWorkerBase& data, const Uint8* proc)
+template<bool Profile>
+static inline void scriptExe(ScriptWorkerBase& data, const Uint8* proc, Uint64& ops)
 {
 	ProgPos curr = ProgPos::Start;
 	//--------------------------------------------------
 	//			helper macros for this function
 	//--------------------------------------------------
-	#define MACRO_FUNC_ARRAY(NAME, ...) + helper::FuncGroup<MACRO_FUNC_ID(NAME)>::FuncList{}
-	#define MACRO_FUNC_ARRAY_LOOP(POS) \
-		case (POS): \
+	#define MACRO_FUNC_ARRAY_CALL(POS) \
 		{ \
 			using currType = helper::GetType<func, POS>; \
+			if constexpr (Profile) ++ops; \
 			const auto p = proc + (int)curr; \
 			curr += currType::offset; \
 			const auto ret = currType::func(data, p, curr); \
@@ -409,13 +542,31 @@ static inline void scriptExe(ScriptWorkerBase& data, const Uint8* proc)
 					goto errorLabel; \
 				} \
 			} \
-			else \
-				continue; \
 		}
+#ifdef SCRIPT_THREADED_DISPATCH
+	#define MACRO_FUNC_ARRAY_LABEL(POS) &&procLabel##POS,
+	#define MACRO_FUNC_ARRAY_LOOP(POS) \
+		procLabel##POS: \
+		MACRO_FUNC_ARRAY_CALL(POS) \
+		goto *dispatch[proc[(int)curr++]];
+#else
+	#define MACRO_FUNC_ARRAY_LOOP(POS) \
+		case (POS): \
+		MACRO_FUNC_ARRAY_CALL(POS) \
+		continue;
+#endif
 	//--------------------------------------------------
 
-	using func = decltype(MACRO_PROC_DEFINITION(MACRO_FUNC_ARRAY));
+	using func = ProcFuncList;
+
+#ifdef SCRIPT_THREADED_DISPATCH
+	// every operation jumps directly to next one, this is easier to predict for CPU than one shared `switch`
+	static const void* const dispatch[256] = { MACRO_TOKEN_COPY_256(MACRO_FUNC_ARRAY_LABEL) };
 
+	goto *dispatch[proc[(int)curr++]];
+
+	MACRO_TOKEN_COPY_256(MACRO_FUNC_ARRAY_LOOP)
+#else
 	while (true)
 	{
 		switch (proc[(int)curr++])
@@ -423,12 +574,14 @@ static inline void scriptExe(ScriptWorkerBase& data, const Uint8* proc)
 		MACRO_COPY_256(MACRO_FUNC_ARRAY_LOOP, 0)
 		}
 	}
+#endif
 
 	//--------------------------------------------------
 	//			removing helper macros
 	//--------------------------------------------------
 	#undef MACRO_FUNC_ARRAY_LOOP
-	#undef MACRO_FUNC_ARRAY
+	#undef MACRO_FUNC_ARRAY_LABEL
+	#undef MACRO_FUNC_ARRAY_CALL
 	//--------------------------------------------------
 
 	errorLabel:
@@ -467,60 +620,94 @@ void ScriptWorkerBlit::executeBlit(const Surface* src, Surface* dest, int x, int
 
 	if (_proc)
 	{
-		if (_events)
+		Uint64 ops = 0;
+		auto blit = [&](auto profileTag)
 		{
-			ShaderDrawFunc(
-				[&](Uint8& destStuff, const Uint8& srcStuff)
+			constexpr bool Profile = decltype(profileTag)::value;
+			auto run = [&](Uint8 srcStuff, Uint8 destStuff)
+			{
+				ScriptWorkerBlit::Output arg = { srcStuff, destStuff };
+				set(arg);
+				if (_events)
 				{
-					if (srcStuff)
+					auto ptr = _events;
+					while (*ptr)
 					{
-						ScriptWorkerBlit::Output arg = { srcStuff, destStuff };
-						set(arg);
-						auto ptr = _events;
-						while (*ptr)
-						{
-							reset(arg);
-							scriptExe(*this, ptr->data());
-							++ptr;
-						}
+						reset(arg);
+						scriptExe<Profile>(*this, ptr->data(), ops);
 						++ptr;
+					}
+					++ptr;
+
+					reset(arg);
+					scriptExe<Profile>(*this, _proc, ops);
 
+					while (*ptr)
+					{
 						reset(arg);
-						scriptExe(*this, _proc);
+						scriptExe<Profile>(*this, ptr->data(), ops);
+						++ptr;
+					}
+				}
+				else
+				{
+					scriptExe<Profile>(*this, _proc, ops);
+				}
+				get(arg);
+				return arg.getFirst();
+			};
 
-						while (*ptr)
+			if (_colorOnly)
+			{
+				// result depends only on source color, each color needs to be computed only once,
+				// most sprites use only few dozens of colors for thousands of pixels.
+				int colors[256];
+				bool known[256] = { };
+				ShaderDrawFunc(
+					[&](Uint8& destStuff, const Uint8& srcStuff)
+					{
+						if (srcStuff)
 						{
-							reset(arg);
-							scriptExe(*this, ptr->data());
-							++ptr;
+							if (!known[srcStuff])
+							{
+								colors[srcStuff] = run(srcStuff, 0);
+								known[srcStuff] = true;
+							}
+							if (colors[srcStuff]) destStuff = colors[srcStuff];
 						}
-						++ptr;
+					},
+					destShader,
+					srcShader
+				);
+			}
+			else
+			{
+				ShaderDrawFunc(
+					[&](Uint8& destStuff, const Uint8& srcStuff)
+					{
+						if (srcStuff)
+						{
+							const int color = run(srcStuff, destStuff);
+							if (color) destStuff = color;
+						}
+					},
+					destShader,
+					srcShader
+				);
+			}
+		};
 
-						get(arg);
-						if (arg.getFirst()) destStuff = arg.getFirst();
-					}
-				},
-				destShader,
-				srcShader
-			);
+		if (Options::oxceScriptProfiler)
+		{
+			// timing every pixel would cost more than the scripts, whole blit is counted as one call of the main script
+			const auto start = std::chrono::steady_clock::now();
+			blit(std::true_type{});
+			const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+			ScriptProfiler::addCall(_proc, time.count(), ops);
 		}
 		else
 		{
-			ShaderDrawFunc(
-				[&](Uint8& destStuff, const Uint8& srcStuff)
-				{
-					if (srcStuff)
-					{
-						ScriptWorkerBlit::Output arg = { srcStuff, destStuff };
-						set(arg);
-						scriptExe(*this, _proc);
-						get(arg);
-						if (arg.getFirst()) destStuff = arg.getFirst();
-					}
-				},
-				destShader,
-				srcShader
-			);
+			blit(std::false_type{});
 		}
 	}
 	else
@@ -537,7 +724,18 @@ void ScriptWorkerBase::executeBase(const Uint8* proc)
 {
 	if (proc)
 	{
-		scriptExe(*this, proc);
+		Uint64 ops = 0;
+		if (Options::oxceScriptProfiler)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			scriptExe<true>(*this, proc, ops);
+			const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+			ScriptProfiler::addCall(proc, time.count(), ops);
+		}
+		else
+		{
+			scriptExe<false>(*this, proc, ops);
+		}
 	}
 }
 
@@ -2058,6 +2256,21 @@ void ParserWriter::relese()
 		}
 	);
 
+	if (Options::oxceScriptOptimize)
+	{
+		optimize();
+	}
+
+	container._outputUsed = 0;
+	for (Uint8 i = 0; i < parser.getParamSize(); ++i)
+	{
+		const auto reg = parser.getParamData(i)->getValueOrDefulat<RegEnum>(RegInvalid);
+		if (reg != RegInvalid && regReferenced.test(reg))
+		{
+			container._outputUsed |= 1 << i;
+		}
+	}
+
 	auto textTotalSize = 0u;
 	refTexts.forEachPosition(
 		[&](auto pos, ScriptRef value)
@@ -2118,6 +2331,61 @@ void ParserWriter::relese()
 	);
 }
 
+/**
+ * Simple optimizations of finished operations.
+ * Jumps to `goto` are redirected to its target and pairs of operations
+ * that often follow each other are replaced by one fused operation.
+ * Size of code do not change, so all positions stay valid.
+ */
+void ParserWriter::optimize()
+{
+	auto& proc = container._proc;
+	const auto readLabel = [&](ProgPos pos)
+	{
+		ProgPos value;
+		memcpy(&value, &proc[static_cast<size_t>(pos)], sizeof(value));
+		return value;
+	};
+
+	std::vector<bool> jumpTarget(proc.size() + 1, false);
+	refLabels.forEachPosition(
+		[&](auto pos, ProgPos value)
+		{
+			// limit number of jumps in case of infinite loop of `goto`
+			for (int i = 0; i < 16 && proc[static_cast<size_t>(value)] == Proc_goto; ++i)
+			{
+				value = readLabel(static_cast<ProgPos>(static_cast<size_t>(value) + 1));
+			}
+			updateReserved<ProgPos>(pos, value);
+			jumpTarget[static_cast<size_t>(value)] = true;
+		}
+	);
+
+	size_t curr = 0;
+	while (curr < proc.size())
+	{
+		const auto first = proc[curr];
+		if (first >= Proc_BaseMax)
+		{
+			// already fused or not an operation
+			break;
+		}
+		const auto next = curr + 1 + ProcArgSize[first];
+		if (next < proc.size() && !jumpTarget[next])
+		{
+			const auto second = proc[next];
+			const auto fused = second < Proc_BaseMax ? getFusedProc(first, second) : 0;
+			if (fused)
+			{
+				proc[curr] = fused;
+				curr = next + 1 + ProcArgSize[second];
+				continue;
+			}
+		}
+		curr = next;
+	}
+}
+
 /**
  * Returns reference based on name.
  * @param s name of reference.
@@ -2324,6 +2592,7 @@ bool ParserWriter::pushRegTry(const ScriptRefData& data, ArgEnum type)
 	if (data && ArgCompatible(type, data.type, 0) && data.getValue<RegEnum>() != RegInvalid)
 	{
 		pushValue(static_cast<Uint8>(data.getValue<RegEnum>()));
+		regReferenced.set(data.getValue<RegEnum>());
 		return true;
 	}
 	return false;
@@ -2815,6 +3084,10 @@ bool ScriptParserBase::parseBase(ScriptContainerBase& destScript, const std::str
 			}
 			help.relese();
 			destScript = std::move(tempScript);
+			if (Options::oxceScriptProfiler)
+			{
+				ScriptProfiler::addScript(destScript.data(), _name, parentName);
+			}
 			return true;
 		}
 
@@ -2983,7 +3256,10 @@ void ScriptParserBase::parseNode(ScriptContainerBase& container, const std::stri
 	}
 	if (!container && !getDefault().empty())
 	{
-		parseBase(container, parentName, getDefault());
+		if (parseBase(container, parentName, getDefault()))
+		{
+			container._default = true;
+		}
 	}
 }
 
@@ -2998,7 +3274,10 @@ void ScriptParserBase::parseCode(ScriptContainerBase& container, const std::stri
 	}
 	if (!container && !getDefault().empty())
 	{
-		parseBase(container, parentName, getDefault());
+		if (parseBase(container, parentName, getDefault()))
+		{
+			container._default = true;
+		}
 	}
 }
 
@@ -3260,7 +3539,16 @@ void ScriptParserEventsBase::load(const YAML::Node& scripts)
 					continue;
 				}
 
-				if (false == parseBase(scp, "Global Event Script", i["code"].as<std::string>("")))
+				std::string scriptName = "Global Event Script";
+				for (auto* p : { &newNode, &updateNode, &overrideNode })
+				{
+					if (haveNode(*p))
+					{
+						scriptName += " '" + std::get<YAML::Node>(*p).as<std::string>() + "'";
+					}
+				}
+
+				if (false == parseBase(scp, scriptName, i["code"].as<std::string>("")))
 				{
 					continue;
 				}
@@ -373,7 +373,10 @@ struct TypeInfo
 class ScriptContainerBase
 {
 	friend struct ParserWriter;
+	friend class ScriptParserBase;
 	std::vector<Uint8> _proc;
+	Uint16 _outputUsed = 0;
+	bool _default = false;
 
 public:
 	/// Constructor.
@@ -402,6 +405,18 @@ public:
 	{
 		return *this ? _proc.data() : nullptr;
 	}
+
+	/// Test if script reads or writes given output argument.
+	bool isOutputUsed(size_t i) const
+	{
+		return _outputUsed & (1 << i);
+	}
+
+	/// Test if script is default code of its parser.
+	bool isDefault() const
+	{
+		return _default;
+	}
 };
 
 /**
@@ -444,11 +459,52 @@ public:
 	{
 		return _current.data();
 	}
+	/// Get main script.
+	const ScriptContainerBase& dataCurrent() const
+	{
+		return _current;
+	}
 	/// Get pointer to proc data.
 	const ScriptContainerBase* dataEvents() const
 	{
 		return _events;
 	}
+	/// Test if only default code of parser is run, without any global events.
+	bool isDefault() const
+	{
+		if (_current && !_current.isDefault())
+		{
+			return false;
+		}
+		auto ptr = _events;
+		if (ptr)
+		{
+			// events before, separator, events after
+			if (*ptr || *(ptr + 1))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	/// Test if there is no script or global event to run at all.
+	bool empty() const
+	{
+		if (_current)
+		{
+			return false;
+		}
+		auto ptr = _events;
+		if (ptr)
+		{
+			// events before, separator, events after
+			if (*ptr || *(ptr + 1))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
 };
 
 /**
@@ -803,13 +859,39 @@ class ScriptWorkerBlit : public ScriptWorkerBase
 	/// Current script set in worker.
 	const Uint8* _proc;
 	const ScriptContainerBase* _events;
+	/// Scripts do not look at destination pixel, result depends only on source color.
+	bool _colorOnly;
+
+	/// Check if all scripts ignore destination pixel.
+	static bool isColorOnly(const ScriptContainerBase& c, const ScriptContainerBase* events)
+	{
+		if (c.isOutputUsed(1))
+		{
+			return false;
+		}
+		if (events)
+		{
+			// events are two lists, each ended by empty script
+			for (int i = 0; i < 2; ++i, ++events)
+			{
+				for (; *events; ++events)
+				{
+					if (events->isOutputUsed(1))
+					{
+						return false;
+					}
+				}
+			}
+		}
+		return true;
+	}
 
 public:
 	/// Type of output value from script.
 	using Output = ScriptOutputArgs<int&, int>;
 
 	/// Default constructor.
-	ScriptWorkerBlit() : ScriptWorkerBase(), _proc(nullptr), _events(nullptr)
+	ScriptWorkerBlit() : ScriptWorkerBase(), _proc(nullptr), _events(nullptr), _colorOnly(false)
 	{
 
 	}
@@ -824,6 +906,7 @@ public:
 		{
 			_proc = c.data();
 			_events = nullptr;
+			_colorOnly = isColorOnly(c, _events);
 			updateBase<Output>(args...);
 		}
 	}
@@ -838,6 +921,7 @@ public:
 		{
 			_proc = c.data();
 			_events = c.dataEvents();
+			_colorOnly = isColorOnly(c.dataCurrent(), _events);
 			updateBase<Output>(args...);
 		}
 	}
@@ -852,6 +936,7 @@ public:
 	{
 		_proc = nullptr;
 		_events = nullptr;
+		_colorOnly = false;
 	}
 };
 
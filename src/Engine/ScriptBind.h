@@ -20,6 +20,7 @@
 #include "Script.h"
 #include "Exception.h"
 #include "Logger.h"
+#include <bitset>
 #include <functional>
 #include <utility>
 
@@ -155,6 +156,8 @@ struct ParserWriter
 
 	/// index of used script registers.
 	RegEnum regIndexUsed;
+	/// registers referenced by any operation.
+	std::bitset<ScriptMaxReg> regReferenced;
 
 	/// Stack of registers limited to code blocks.
 	std::vector<ScriptRefData> regStack;
@@ -171,6 +174,8 @@ struct ParserWriter
 
 	/// Final fixes of data.
 	void relese();
+	/// Optimize finished operations.
+	void optimize();
 
 	/// Get reference based on name.
 	ScriptRefData getReferece(const ScriptRef& s) const;
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2010-2023 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ScriptProfiler.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+#include "Logger.h"
+
+namespace OpenXcom
+{
+
+namespace ScriptProfiler
+{
+
+namespace
+{
+
+/**
+ * Statistics of one script.
+ */
+struct ScriptStats
+{
+	std::string mod, hook, name;
+	Uint64 calls = 0;
+	Uint64 totalTime = 0;
+	Uint64 maxTime = 0;
+	Uint64 operations = 0;
+};
+
+std::string _currentMod;
+std::vector<ScriptStats> _stats;
+std::unordered_map<const Uint8*, size_t> _index;
+
+/**
+ * Formats nanoseconds as milliseconds.
+ */
+std::string toMs(Uint64 ns)
+{
+	std::ostringstream ss;
+	ss << std::fixed << std::setprecision(3) << ns / 1000000.0;
+	return ss.str();
+}
+
+}
+
+/**
+ * Sets the mod whose scripts are being parsed, every script
+ * registered after this is attributed to it.
+ * @param mod Mod id.
+ */
+void setMod(const std::string &mod)
+{
+	_currentMod = mod;
+}
+
+/**
+ * Registers a freshly parsed script. If its code reuses the memory
+ * of an old discarded script, the old entry is taken over.
+ * @param proc Compiled script code.
+ * @param hook Name of the script parser, eg. `recolorUnitSprite`.
+ * @param name Name of the rule or event that owns the script.
+ */
+void addScript(const Uint8 *proc, const std::string &hook, const std::string &name)
+{
+	if (!proc)
+	{
+		return;
+	}
+	auto it = _index.find(proc);
+	if (it == _index.end())
+	{
+		it = _index.emplace(proc, _stats.size()).first;
+		_stats.emplace_back();
+	}
+	ScriptStats &stats = _stats[it->second];
+	stats = ScriptStats{};
+	stats.mod = _currentMod;
+	stats.hook = hook;
+	stats.name = name;
+}
+
+/**
+ * Records one execution of a script.
+ * @param proc Compiled script code.
+ * @param nanoseconds Time taken by the script.
+ * @param operations Number of script operations executed.
+ */
+void addCall(const Uint8 *proc, Uint64 nanoseconds, Uint64 operations)
+{
+	auto it = _index.find(proc);
+	if (it == _index.end())
+	{
+		// scripts parsed before the profiler was turned on
+		it = _index.emplace(proc, _stats.size()).first;
+		_stats.emplace_back();
+		_stats.back().name = "unknown";
+	}
+	ScriptStats &stats = _stats[it->second];
+	stats.calls += 1;
+	stats.totalTime += nanoseconds;
+	stats.maxTime = std::max(stats.maxTime, nanoseconds);
+	stats.operations += operations;
+}
+
+/**
+ * Writes the collected statistics to the log, sorted by
+ * total time so the scripts worth optimizing come first.
+ * Blit scripts count one call per blitted surface.
+ */
+void report()
+{
+	std::vector<const ScriptStats*> sorted;
+	Uint64 totalTime = 0;
+	for (const auto &stats : _stats)
+	{
+		if (stats.calls)
+		{
+			sorted.push_back(&stats);
+			totalTime += stats.totalTime;
+		}
+	}
+	if (sorted.empty())
+	{
+		return;
+	}
+	std::sort(sorted.begin(), sorted.end(), [](const ScriptStats *a, const ScriptStats *b) { return a->totalTime > b->totalTime; });
+
+	Log(LOG_INFO) << "Script profile, " << sorted.size() << " scripts, " << toMs(totalTime) << " ms total:";
+	Log(LOG_INFO) << "  total ms | max ms | calls | ops/call | mod | hook | script";
+	for (const auto *stats : sorted)
+	{
+		Log(LOG_INFO) << "  " << toMs(stats->totalTime)
+			<< " | " << toMs(stats->maxTime)
+			<< " | " << stats->calls
+			<< " | " << stats->operations / stats->calls
+			<< " | " << stats->mod
+			<< " | " << stats->hook
+			<< " | " << stats->name;
+	}
+}
+
+/**
+ * Forgets all scripts and statistics, used when the mods are reloaded.
+ */
+void clear()
+{
+	_stats.clear();
+	_index.clear();
+	_currentMod.clear();
+}
+
+}
+
+}
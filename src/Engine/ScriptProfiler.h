@@ -0,0 +1,45 @@
+#pragma once
+/*
+ * Copyright 2010-2023 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <SDL_types.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Collects execution statistics of mod scripts when `oxceScriptProfiler` is enabled.
+ * Scripts are identified by their compiled code, so they need to be
+ * registered when parsed. Only meant to be used from the main thread.
+ */
+namespace ScriptProfiler
+{
+	/// Sets the mod whose scripts are being parsed.
+	void setMod(const std::string &mod);
+	/// Registers a freshly parsed script.
+	void addScript(const Uint8 *proc, const std::string &hook, const std::string &name);
+	/// Records one execution of a script.
+	void addCall(const Uint8 *proc, Uint64 nanoseconds, Uint64 operations);
+	/// Writes the collected statistics to the log, slowest scripts first.
+	void report();
+	/// Forgets all scripts and statistics.
+	void clear();
+}
+
+}
@@ -21,6 +21,7 @@
 #include "ShaderMove.h"
 #include <vector>
 #include <algorithm>
+#include <unordered_map>
 #include <SDL_gfxPrimitives.h>
 #include <SDL_image.h>
 #include "../lodepng.h"
@@ -29,6 +30,8 @@
 #include "Logger.h"
 #include "SDL2Helpers.h"
 #include "FileMap.h"
+#include "Parallel.h"
+#include "CrossPlatform.h"
 #ifdef _WIN32
 #include <malloc.h>
 #endif
@@ -47,6 +50,20 @@ namespace OpenXcom
 namespace
 {
 
+/**
+ * PNG file decoded by Surface::preloadImages(), waiting to be loaded.
+ */
+struct PreloadedImage
+{
+	std::vector<unsigned char> pixels;
+	unsigned width = 0, height = 0;
+	unsigned error = 0;
+	lodepng::State state;
+};
+
+/// Images decoded ahead of time, by filename.
+std::unordered_map<std::string, PreloadedImage> preloadedImages;
+
 /**
  * Helper function counting pitch in bytes with 16byte padding
  * @param bpp bits per pixel
@@ -363,11 +380,30 @@ void Surface::loadImage(const std::string &filename)
 	_surface = nullptr;
 
 	Log(LOG_VERBOSE) << "Loading image: " << filename;
+
+	// Use the pixels if preloadImages() already decoded this file
+	auto preloaded = preloadedImages.find(filename);
+	bool wasPreloaded = preloaded != preloadedImages.end();
+	if (wasPreloaded)
+	{
+		PreloadedImage image = std::move(preloaded->second);
+		preloadedImages.erase(preloaded);
+		if (image.error)
+		{
+			Log(LOG_ERROR) << "Image " << filename << " lodepng failed:" << lodepng_error_text(image.error);
+		}
+		else if (lodepng_get_bpp(&image.state.info_png.color) == 8)
+		{
+			loadPng(filename, image.pixels, image.width, image.height, &image.state.info_png.color);
+			return;
+		}
+	}
+
 	auto rw = FileMap::getRWops(filename);
 	if (!rw) { return; } // relevant message gets logged in FileMap.
 
 	// Try loading with LodePNG first
-	if (CrossPlatform::compareExt(filename, "png"))
+	if (CrossPlatform::compareExt(filename, "png") && !wasPreloaded)
 	{
 		size_t size;
 		void *data = SDL_LoadFile_RW(rw, &size, SDL_FALSE);
@@ -388,32 +424,7 @@ void Surface::loadImage(const std::string &filename)
 				unsigned bpp = lodepng_get_bpp(color);
 				if (bpp == 8)
 				{
-					*this = Surface(width, height, 0, 0);
-					setPalette((SDL_Color*)color->palette, 0, color->palettesize);
-
-					ShaderDrawFunc(
-						[](Uint8& dest, unsigned char& src)
-						{
-							dest = src;
-						},
-						ShaderSurface(this),
-						ShaderSurface(SurfaceRaw<unsigned char>(image, width, height))
-					);
-					int transparent = 0;
-					for (int c = 0; c < _surface->format->palette->ncolors; ++c)
-					{
-						SDL_Color *palColor = _surface->format->palette->colors + c;
-						if (palColor->unused == 0)
-						{
-							transparent = c;
-							break;
-						}
-					}
-					FixTransparent(_surface, transparent);
-					if (transparent != 0)
-					{
-						Log(LOG_WARNING) << "Image " << filename << " (from lodepng) has incorrect transparent color index " << transparent << " (instead of 0).";
-					}
+					loadPng(filename, image, width, height, color);
 				}
 			} else {
 				Log(LOG_ERROR) << "Image " << filename << " lodepng failed:" << lodepng_error_text(error);
@@ -451,6 +462,111 @@ void Surface::loadImage(const std::string &filename)
 	}
 }
 
+/**
+ * Copies the pixels and palette of a decoded 8bpp PNG into the surface.
+ * @param filename Filename of the image, for warnings.
+ * @param image Decoded pixels.
+ * @param width Width of the image.
+ * @param height Height of the image.
+ * @param color Color mode of the image, with its palette.
+ */
+void Surface::loadPng(const std::string &filename, const std::vector<unsigned char> &image, unsigned width, unsigned height, const LodePNGColorMode *color)
+{
+	*this = Surface(width, height, 0, 0);
+	setPalette((SDL_Color*)color->palette, 0, color->palettesize);
+
+	ShaderDrawFunc(
+		[](Uint8& dest, const unsigned char& src)
+		{
+			dest = src;
+		},
+		ShaderSurface(this),
+		ShaderSurface(SurfaceRaw<const unsigned char>(image, width, height))
+	);
+	int transparent = 0;
+	for (int c = 0; c < _surface->format->palette->ncolors; ++c)
+	{
+		SDL_Color *palColor = _surface->format->palette->colors + c;
+		if (palColor->unused == 0)
+		{
+			transparent = c;
+			break;
+		}
+	}
+	FixTransparent(_surface, transparent);
+	if (transparent != 0)
+	{
+		Log(LOG_WARNING) << "Image " << filename << " (from lodepng) has incorrect transparent color index " << transparent << " (instead of 0).";
+	}
+}
+
+/**
+ * Reads PNG files on the main thread and decodes them on worker threads,
+ * so loadImage() only has to copy the pixels. Files that are not PNG,
+ * or can't be read, are skipped and loaded the usual way.
+ * @param filenames Image files that will be loaded next.
+ */
+void Surface::preloadImages(const std::vector<std::string> &filenames)
+{
+	std::vector<std::pair<std::string, PreloadedImage>> work;
+	std::vector<std::vector<unsigned char>> files;
+	for (const auto& filename : filenames)
+	{
+		if (!CrossPlatform::compareExt(filename, "png") || preloadedImages.find(filename) != preloadedImages.end() || !FileMap::fileExists(filename))
+		{
+			continue;
+		}
+		auto rw = FileMap::getRWops(filename);
+		if (!rw)
+		{
+			continue;
+		}
+		size_t size;
+		void *data = SDL_LoadFile_RW(rw, &size, SDL_TRUE);
+		if ((data != NULL) && (size > 8 + 12 + 12)) // minimal PNG file size: header and two empty chunks
+		{
+			work.push_back(std::make_pair(filename, PreloadedImage()));
+			files.push_back(std::vector<unsigned char>((unsigned char*)data, (unsigned char*)data + size));
+		}
+		if (data) { SDL_free(data); }
+	}
+	if (work.empty())
+	{
+		return;
+	}
+
+	Log(LOG_VERBOSE) << "Decoding " << work.size() << " images on " << std::min((size_t)Parallel::getThreadCount(), work.size()) << " threads";
+	Parallel::forEach(work.size(), [&](size_t i)
+	{
+		PreloadedImage &image = work[i].second;
+		image.state.decoder.color_convert = 0;
+		image.error = lodepng::decode(image.pixels, image.width, image.height, image.state, files[i]);
+		std::vector<unsigned char>().swap(files[i]);
+	});
+
+	for (auto& pair : work)
+	{
+		preloadedImages[pair.first] = std::move(pair.second);
+	}
+}
+
+/**
+ * Checks if any decoded images are waiting to be loaded.
+ * @return True if there are preloaded images.
+ */
+bool Surface::hasPreloadedImages()
+{
+	return !preloadedImages.empty();
+}
+
+/**
+ * Drops the images decoded ahead of time that were not loaded.
+ */
+void Surface::clearPreloadedImages()
+{
+	preloadedImages.clear();
+}
+
 /**
  * Loads the contents of an X-Com SPK image file into
  * the surface. SPK files are compressed with a custom
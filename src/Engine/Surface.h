@@ -25,6 +25,8 @@
 #include <assert.h>
 #include "GraphSubset.h"
 
+struct LodePNGColorMode;
+
 namespace OpenXcom
 {
 
@@ -95,6 +97,8 @@ protected:
 	void rawCopy(const std::vector<T> &bytes);
 	/// Resizes the surface.
 	void resize(int width, int height);
+	/// Copies a decoded 8bpp PNG into the surface.
+	void loadPng(const std::string &filename, const std::vector<unsigned char> &image, unsigned width, unsigned height, const LodePNGColorMode *color);
 public:
 	/// Default empty surface.
 	Surface();
@@ -129,6 +133,12 @@ public:
 	void loadBdy(const std::string &filename);
 	/// Loads a general image file.
 	void loadImage(const std::string &filename);
+	/// Decodes image files on worker threads ahead of loading them.
+	static void preloadImages(const std::vector<std::string> &filenames);
+	/// Checks if any decoded images are waiting to be loaded.
+	static bool hasPreloadedImages();
+	/// Drops the images decoded ahead of time that were not loaded.
+	static void clearPreloadedImages();
 	/// Clears the surface's contents with a specified colour.
 	void clear();
 	/// Offsets the surface's colors by a set amount.
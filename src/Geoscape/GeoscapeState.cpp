@@ -139,7 +139,7 @@ namespace OpenXcom
  * Initializes all the elements in the Geoscape screen.
  * @param game Pointer to the core game.
  */
-GeoscapeState::GeoscapeState() : _pause(false), _zoomInEffectDone(false), _zoomOutEffectDone(false), _minimizedDogfights(0), _slowdownCounter(0)
+GeoscapeState::GeoscapeState() : _pause(false), _zoomInEffectDone(false), _zoomOutEffectDone(false), _activeCraftsRevision(0), _activeCraftsValid(false), _minimizedDogfights(0), _slowdownCounter(0)
 {
 	int screenWidth = Options::baseXGeoscape;
 	int screenHeight = Options::baseYGeoscape;
@@ -886,16 +886,24 @@ void GeoscapeState::timeAdvance()
 
 /**
  * Update list of active crafts.
+ * The list is only rebuilt when a craft leaves, returns to,
+ * or is destroyed outside its base (see Craft::getActiveRevision).
  * @return Const pointer to updated list.
  */
 const std::vector<Craft*>* GeoscapeState::updateActiveCrafts()
 {
+	if (_activeCraftsValid && _activeCraftsRevision == Craft::getActiveRevision())
+	{
+		return &_activeCrafts;
+	}
+	_activeCraftsValid = true;
+	_activeCraftsRevision = Craft::getActiveRevision();
 	_activeCrafts.clear();
 	for (auto* xbase : *_game->getSavedGame()->getBases())
 	{
 		for (auto* xcraft : *xbase->getCrafts())
 		{
-			if (xcraft->getStatus() == "STR_OUT" && !xcraft->isDestroyed())
+			if (xcraft->getStatus() == CRAFT_OUT && !xcraft->isDestroyed())
 			{
 				_activeCrafts.push_back(xcraft);
 			}
@@ -904,6 +912,51 @@ const std::vector<Craft*>* GeoscapeState::updateActiveCrafts()
 	return &_activeCrafts;
 }
 
+/**
+ * Fills the grid of active craft positions, used to find
+ * craft near hunter-killers and alien bases.
+ * Entry IDs are indexes in the list of active craft.
+ * @param activeCrafts List of active crafts.
+ */
+void GeoscapeState::updateCraftGrid(const std::vector<Craft*>* activeCrafts)
+{
+	_craftGrid.clear();
+	for (size_t i = 0; i < activeCrafts->size(); ++i)
+	{
+		_craftGrid.insert(i, (*activeCrafts)[i], 0.0);
+	}
+}
+
+/**
+ * Fills the grids of radar coverage of bases and active craft,
+ * used to find the detectors that can possibly see a UFO.
+ * Entry IDs are indexes in the list of bases and of active craft.
+ * Ranges are padded by a mile to stay conservative.
+ * @param activeCrafts List of active crafts.
+ */
+void GeoscapeState::updateRadarGrids(const std::vector<Craft*>* activeCrafts)
+{
+	_baseRadarGrid.clear();
+	auto* bases = _game->getSavedGame()->getBases();
+	for (size_t i = 0; i < bases->size(); ++i)
+	{
+		int range = (*bases)[i]->getMaxRadarRange();
+		if (range > 0)
+		{
+			_baseRadarGrid.insert(i, (*bases)[i], Nautical(range + 1));
+		}
+	}
+	_craftRadarGrid.clear();
+	for (size_t i = 0; i < activeCrafts->size(); ++i)
+	{
+		int range = (*activeCrafts)[i]->getCraftStats().radarRange;
+		if (range > 0)
+		{
+			_craftRadarGrid.insert(i, (*activeCrafts)[i], Nautical(range + 1));
+		}
+	}
+}
+
 /**
  * Takes care of any game logic that has to
  * run every game second, like craft movement.
@@ -1378,7 +1431,7 @@ void GeoscapeState::time5Seconds()
 				}
 				else if (x != 0)
 				{
-					if (x->getStatus() != "STR_OUT" || x->isDestroyed())
+					if (x->getStatus() != CRAFT_OUT || x->isDestroyed())
 					{
 						xcraft->returnToBase();
 					}
@@ -1492,7 +1545,7 @@ void GeoscapeState::time10Minutes()
 		// Fuel consumption for XCOM craft.
 		for (auto* xcraft : *xbase->getCrafts())
 		{
-			if (xcraft->getStatus() == "STR_OUT")
+			if (xcraft->getStatus() == CRAFT_OUT)
 			{
 				int escortSpeed = 0;
 				{
@@ -1574,6 +1627,7 @@ void GeoscapeState::time10Minutes()
 void GeoscapeState::ufoHuntingAndEscorting()
 {
 	auto* activeCrafts = updateActiveCrafts();
+	updateCraftGrid(activeCrafts);
 
 	for (auto* ufo : *_game->getSavedGame()->getUfos())
 	{
@@ -1596,9 +1650,15 @@ void GeoscapeState::ufoHuntingAndEscorting()
 				}
 			}
 
-			// look for more attractive target
-			for (auto* craft : *activeCrafts)
+			// look for more attractive target, only craft that can be inside radar range
+			_gridCandidates.clear();
+			if (ufo->getCraftStats().radarRange > 0)
 			{
+				_craftGrid.query(ufo, Nautical(ufo->getCraftStats().radarRange + 1), _gridCandidates);
+			}
+			for (int i : _gridCandidates)
+			{
+				Craft *craft = (*activeCrafts)[i];
 				if (!craft->isIgnoredByHK() && !craft->getRules()->isUndetectable())
 				{
 					int tmpAttraction = craft->getHunterKillerAttraction(ufo->getHuntMode());
@@ -1664,6 +1724,7 @@ void GeoscapeState::ufoHuntingAndEscorting()
 void GeoscapeState::baseHunting()
 {
 	auto* activeCrafts = updateActiveCrafts();
+	updateCraftGrid(activeCrafts);
 
 	for (auto* ab : *_game->getSavedGame()->getAlienBases())
 	{
@@ -1677,10 +1738,12 @@ void GeoscapeState::baseHunting()
 			{
 				// Look for nearby craft
 				bool started = false;
-				for (auto* craft : *activeCrafts)
+				_craftGrid.query(ab, Nautical(ab->getDeployment()->getBaseDetectionRange() + 1), _gridCandidates);
+				for (int i : _gridCandidates)
 				{
+					Craft *craft = (*activeCrafts)[i];
 					// Craft is flying (i.e. not in base)
-					if (craft->getStatus() == "STR_OUT" && !craft->isDestroyed() && !craft->getRules()->isUndetectable())
+					if (craft->getStatus() == CRAFT_OUT && !craft->isDestroyed() && !craft->getRules()->isUndetectable())
 					{
 						// Craft is close enough and RNG is in our favour
 						if (craft->getDistance(ab) < Nautical(ab->getDeployment()->getBaseDetectionRange()) && RNG::percent(ab->getDeployment()->getBaseDetectionChance()))
@@ -1878,20 +1941,20 @@ void GeoscapeState::time30Minutes()
 	{
 		for (auto* xcraft : *xbase->getCrafts())
 		{
-			if (xcraft->getStatus() == "STR_REFUELLING")
+			if (xcraft->getStatus() == CRAFT_REFUELLING)
 			{
 				std::string item = xcraft->refuel();
 
 				if (item.empty())
 				{
 					// notification
-					if (xcraft->getStatus() == "STR_READY" && xcraft->getRules()->notifyWhenRefueled())
+					if (xcraft->getStatus() == CRAFT_READY && xcraft->getRules()->notifyWhenRefueled())
 					{
 						std::string msg = tr("STR_CRAFT_IS_READY").arg(xcraft->getName(_game->getLanguage())).arg(xbase->getName());
 						popup(new CraftErrorState(this, msg));
 					}
 					// auto-patrol
-					if (xcraft->getStatus() == "STR_READY" && xcraft->getRules()->canAutoPatrol())
+					if (xcraft->getStatus() == CRAFT_READY && xcraft->getRules()->canAutoPatrol())
 					{
 						if (xcraft->getIsAutoPatrolling())
 						{
@@ -1904,7 +1967,7 @@ void GeoscapeState::time30Minutes()
 								_game->getSavedGame()->getWaypoints()->push_back(w);
 							}
 							xcraft->setDestination(w);
-							xcraft->setStatus("STR_OUT");
+							xcraft->setStatus(CRAFT_OUT);
 						}
 					}
 				}
@@ -1922,6 +1985,7 @@ void GeoscapeState::time30Minutes()
 
 	// can be updated by previous loop
 	auto* activeCrafts = updateActiveCrafts();
+	updateRadarGrids(activeCrafts);
 
 	// Handle UFO detection and give aliens points
 	for (auto* ufo : *_game->getSavedGame()->getUfos())
@@ -2029,15 +2093,34 @@ void GeoscapeState::ufoDetection(Ufo* ufo, const std::vector<Craft*>* activeCraf
 	auto alreadyTracked = ufo->getDetected();
 	auto save = _game->getSavedGame();
 
-	for (auto* base : *_game->getSavedGame()->getBases())
-	{
-		detected = maskBitOr(detected, base->detect(ufo, save, alreadyTracked));
-	}
-
-	for (auto* craft : *activeCrafts)
+	// Detectors out of radar range can't see the UFO, unless a script says otherwise.
+	// Their detection chance is zero, but the roll is still made
+	// so the RNG sequence stays the same as when every detector is tested.
+	auto detectFrom = [&](const auto* detectors, const GlobeGrid& radarGrid, bool useGrid)
 	{
-		detected = maskBitOr(detected, craft->detect(ufo, save, alreadyTracked));
-	}
+		if (useGrid)
+		{
+			radarGrid.query(ufo, 0.0, _gridCandidates);
+		}
+		auto candidate = _gridCandidates.cbegin();
+		for (size_t i = 0; i < detectors->size(); ++i)
+		{
+			if (!useGrid || (candidate != _gridCandidates.cend() && *candidate == (int)i))
+			{
+				detected = maskBitOr(detected, (*detectors)[i]->detect(ufo, save, alreadyTracked));
+				if (useGrid)
+				{
+					++candidate;
+				}
+			}
+			else
+			{
+				RNG::percent(0);
+			}
+		}
+	};
+	detectFrom(_game->getSavedGame()->getBases(), _baseRadarGrid, ufo->getRules()->getScript<ModScript::DetectUfoFromBase>().empty());
+	detectFrom(activeCrafts, _craftRadarGrid, ufo->getRules()->getScript<ModScript::DetectUfoFromCraft>().empty());
 
 	if (!alreadyTracked)
 	{
@@ -2085,11 +2168,11 @@ void GeoscapeState::time1Hour()
 	{
 		for (auto* xcraft : *xbase->getCrafts())
 		{
-			if (xcraft->getStatus() == "STR_REPAIRS")
+			if (xcraft->getStatus() == CRAFT_REPAIRS)
 			{
 				xcraft->repair();
 			}
-			else if (xcraft->getStatus() == "STR_REARMING")
+			else if (xcraft->getStatus() == CRAFT_REARMING)
 			{
 				auto* ammo = xcraft->rearm();
 				if (ammo)
@@ -2101,7 +2184,7 @@ void GeoscapeState::time1Hour()
 					popup(new CraftErrorState(this, msg));
 				}
 			}
-			if (xcraft->getShieldCapacity() > 0 && xcraft->getStatus() != "STR_OUT")
+			if (xcraft->getShieldCapacity() > 0 && xcraft->getStatus() != CRAFT_OUT)
 			{
 				// Recharge craft shields in parallel (no wait for repair/rearm/refuel)
 				xcraft->setShield(xcraft->getShield() + xcraft->getRules()->getShieldRechargeAtBase());
@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http:///www.gnu.org/licenses/>.
  */
 #include "../Engine/State.h"
+#include "GlobeGrid.h"
 #include <list>
 
 namespace OpenXcom
@@ -60,11 +61,19 @@ private:
 	std::list<State*> _popups;
 	std::list<DogfightState*> _dogfights, _dogfightsToBeStarted;
 	std::vector<Craft*> _activeCrafts;
+	unsigned int _activeCraftsRevision;
+	bool _activeCraftsValid;
+	GlobeGrid _craftGrid, _craftRadarGrid, _baseRadarGrid;
+	std::vector<int> _gridCandidates;
 	size_t _minimizedDogfights;
 	int _slowdownCounter;
 
 	/// Update list of active crafts.
 	const std::vector<Craft*>* updateActiveCrafts();
+	/// Update the broad-phase grid of active craft positions.
+	void updateCraftGrid(const std::vector<Craft*>* activeCrafts);
+	/// Update the broad-phase grids of base and craft radar coverage.
+	void updateRadarGrids(const std::vector<Craft*>* activeCrafts);
 
 	void cbxRegionChange(Action *action);
 	void cbxZoneChange(Action *action);
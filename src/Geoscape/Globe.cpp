@@ -1198,7 +1198,7 @@ void Globe::drawRadars()
 		// Draw radars around player craft
 		for (auto* xcraft : *xbase->getCrafts())
 		{
-			if (xcraft->getStatus() != "STR_OUT")
+			if (xcraft->getStatus() != CRAFT_OUT)
 				continue;
 			lat = xcraft->getLatitude();
 			lon = xcraft->getLongitude();
@@ -1630,7 +1630,7 @@ void Globe::drawFlights()
 		for (auto* xcraft : *xbase->getCrafts())
 		{
 			// Hide crafts docked at base
-			if (xcraft->getStatus() != "STR_OUT" || xcraft->getDestination() == 0 /*|| pointBack(xcraft->getLongitude(), xcraft->getLatitude())*/)
+			if (xcraft->getStatus() != CRAFT_OUT || xcraft->getDestination() == 0 /*|| pointBack(xcraft->getLongitude(), xcraft->getLatitude())*/)
 				continue;
 
 			double lon1 = xcraft->getLongitude();
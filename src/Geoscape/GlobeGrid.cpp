@@ -0,0 +1,148 @@
+/*
+ * Copyright 2010-2023 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "GlobeGrid.h"
+#include <algorithm>
+#include <cmath>
+#include "../fmath.h"
+#include "../Savegame/Target.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates an empty grid covering the whole globe.
+ */
+GlobeGrid::GlobeGrid() : _cells(CellsLon * CellsLat)
+{
+}
+
+/**
+ * Removes all entries, keeping the allocated cells for reuse.
+ */
+void GlobeGrid::clear()
+{
+	for (auto& cell : _cells)
+	{
+		cell.clear();
+	}
+}
+
+/**
+ * Calls a function with the index of every cell that a spherical
+ * cap overlaps. The covered area is slightly overestimated.
+ * @param lon Longitude of the cap center in radians.
+ * @param lat Latitude of the cap center in radians.
+ * @param range Angular radius of the cap in radians.
+ * @param func Function called with each cell index.
+ */
+template<typename F>
+void GlobeGrid::forEachCell(double lon, double lat, double range, F func) const
+{
+	const double cellRad = Deg2Rad(CellSize);
+	const double halfPi = M_PI / 2;
+
+	double latMin = lat - range;
+	double latMax = lat + range;
+	bool allLon = range >= M_PI || latMin <= -halfPi || latMax >= halfPi;
+	int lonFirst = 0, lonCount = CellsLon;
+	if (!allLon)
+	{
+		// widest longitude extent of a cap that does not contain a pole
+		double s = std::sin(range) / std::cos(lat);
+		if (s >= 1.0)
+		{
+			allLon = true;
+		}
+		else
+		{
+			double dLon = std::asin(s);
+			double lonMin = lon - dLon;
+			while (lonMin < 0)
+			{
+				lonMin += 2 * M_PI;
+			}
+			lonFirst = (int)(lonMin / cellRad) % CellsLon;
+			int lonLast = (int)std::floor((lonMin + 2 * dLon) / cellRad);
+			lonCount = std::min(CellsLon, lonLast - (int)std::floor(lonMin / cellRad) + 1);
+		}
+	}
+	int latFirst = Clamp((int)std::floor((std::max(latMin, -halfPi) + halfPi) / cellRad), 0, CellsLat - 1);
+	int latLast = Clamp((int)std::floor((std::min(latMax, halfPi) + halfPi) / cellRad), 0, CellsLat - 1);
+
+	for (int y = latFirst; y <= latLast; ++y)
+	{
+		for (int i = 0; i < lonCount; ++i)
+		{
+			func(y * CellsLon + (lonFirst + i) % CellsLon);
+		}
+	}
+}
+
+/**
+ * Adds an entry to every cell overlapped by its cap.
+ * @param id Caller defined ID, usually an index in the caller's list.
+ * @param lon Longitude in radians.
+ * @param lat Latitude in radians.
+ * @param range Angular radius in radians, 0 for a single point.
+ */
+void GlobeGrid::insert(int id, double lon, double lat, double range)
+{
+	forEachCell(lon, lat, range, [&](int cell){ _cells[cell].push_back(id); });
+}
+
+/**
+ * Adds an entry to every cell overlapped by its cap.
+ * @param id Caller defined ID, usually an index in the caller's list.
+ * @param target Target at the center of the cap.
+ * @param range Angular radius in radians, 0 for a single point.
+ */
+void GlobeGrid::insert(int id, const Target *target, double range)
+{
+	insert(id, target->getLongitude(), target->getLatitude(), range);
+}
+
+/**
+ * Collects all entries that share a cell with the query cap.
+ * IDs are returned sorted, so iterating over them follows the
+ * same order as iterating over the caller's full list.
+ * @param lon Longitude in radians.
+ * @param lat Latitude in radians.
+ * @param range Angular radius in radians, 0 for a single point.
+ * @param result Vector to fill with the candidate IDs.
+ */
+void GlobeGrid::query(double lon, double lat, double range, std::vector<int> &result) const
+{
+	result.clear();
+	forEachCell(lon, lat, range, [&](int cell){ result.insert(result.end(), _cells[cell].begin(), _cells[cell].end()); });
+	std::sort(result.begin(), result.end());
+	result.erase(std::unique(result.begin(), result.end()), result.end());
+}
+
+/**
+ * Collects all entries that share a cell with the query cap.
+ * @param target Target at the center of the cap.
+ * @param range Angular radius in radians, 0 for a single point.
+ * @param result Vector to fill with the candidate IDs.
+ */
+void GlobeGrid::query(const Target *target, double range, std::vector<int> &result) const
+{
+	query(target->getLongitude(), target->getLatitude(), range, result);
+}
+
+}
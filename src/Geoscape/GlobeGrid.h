@@ -0,0 +1,65 @@
+#pragma once
+/*
+ * Copyright 2010-2023 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+
+namespace OpenXcom
+{
+
+class Target;
+
+/**
+ * Coarse longitude/latitude bucket grid over the globe.
+ * Used as a broad-phase for range checks between geoscape targets
+ * (radar detection, hunter-killers, alien base hunting).
+ * Each entry is a spherical cap (a target with a range in radians,
+ * zero for a point) stored in every cell it overlaps.
+ * Queries are conservative: they return every entry that can possibly
+ * be within range, the exact test is still up to the caller.
+ */
+class GlobeGrid
+{
+private:
+	/// Size of one cell in degrees.
+	static constexpr int CellSize = 10;
+	static constexpr int CellsLon = 360 / CellSize;
+	static constexpr int CellsLat = 180 / CellSize;
+
+	std::vector<std::vector<int>> _cells;
+
+	/// Calls a function for every cell overlapped by a cap.
+	template<typename F>
+	void forEachCell(double lon, double lat, double range, F func) const;
+
+public:
+	/// Creates an empty grid.
+	GlobeGrid();
+	/// Removes all entries from the grid.
+	void clear();
+	/// Adds an entry covering a cap around a position.
+	void insert(int id, double lon, double lat, double range);
+	/// Adds an entry covering a cap around a target.
+	void insert(int id, const Target *target, double range);
+	/// Gets the sorted IDs of all entries that can be within range of a position.
+	void query(double lon, double lat, double range, std::vector<int> &result) const;
+	/// Gets the sorted IDs of all entries that can be within range of a target.
+	void query(const Target *target, double range, std::vector<int> &result) const;
+};
+
+}
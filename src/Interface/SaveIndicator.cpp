@@ -0,0 +1,73 @@
+/*
+ * Copyright 2010-2023 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SaveIndicator.h"
+#include "../Savegame/AsyncSave.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates a save indicator of the specified size.
+ * @param width Width in pixels.
+ * @param height Height in pixels.
+ * @param x X position in pixels.
+ * @param y Y position in pixels.
+ */
+SaveIndicator::SaveIndicator(int width, int height, int x, int y) : Surface(width, height, x, y), _color(0)
+{
+	_visible = false;
+}
+
+/**
+ *
+ */
+SaveIndicator::~SaveIndicator()
+{
+}
+
+/**
+ * Sets the color of the indicator.
+ * @param color The color to set.
+ */
+void SaveIndicator::setColor(Uint8 color)
+{
+	_color = color;
+	_redraw = true;
+}
+
+/**
+ * Shows the indicator blinking while a save is pending.
+ */
+void SaveIndicator::think()
+{
+	setVisible(AsyncSave::isBusy() && (SDL_GetTicks() / 250) % 2 == 0);
+}
+
+/**
+ * Draws the indicator as a hollow square.
+ */
+void SaveIndicator::draw()
+{
+	Surface::draw();
+	drawRect(0, 0, getWidth(), getHeight(), _color);
+	drawRect(1, 1, getWidth() - 2, getHeight() - 2, 0);
+}
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+/*
+ * Copyright 2010-2023 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../Engine/Surface.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Small blinking marker shown in the corner of the screen
+ * while a save is being written in the background.
+ */
+class SaveIndicator : public Surface
+{
+private:
+	Uint8 _color;
+public:
+	/// Creates a new save indicator.
+	SaveIndicator(int width, int height, int x, int y);
+	/// Cleans up the save indicator.
+	~SaveIndicator();
+	/// Sets the save indicator's color.
+	void setColor(Uint8 color) override;
+	/// Blinks while a save is pending.
+	void think() override;
+	/// Draws the save indicator.
+	void draw() override;
+};
+
+}
@@ -40,6 +40,7 @@ namespace OpenXcom
  */
 DeleteGameState::DeleteGameState(OptionsOrigin origin, const std::string &save) : _origin(origin)
 {
+	_save = save;
 	_filename = Options::getMasterUserFolder() + save;
 	_screen = false;
 
@@ -105,6 +106,10 @@ void DeleteGameState::btnYesClick(Action *)
 		else
 			_game->pushState(new ErrorMessageState(error, _palette, _game->getMod()->getInterface("errorMessages")->getElement("battlescapeColor")->color, "TAC00.SCR", _game->getMod()->getInterface("errorMessages")->getElement("battlescapePalette")->color));
 	}
+	else
+	{
+		SavedGame::removeFromSaveIndex(_save);
+	}
 }
 
 }
@@ -37,7 +37,7 @@ private:
 	TextButton *_btnNo, *_btnYes;
 	Window *_window;
 	Text *_txtMessage;
-	std::string _filename;
+	std::string _save, _filename;
 	OptionsOrigin _origin;
 public:
 	/// Creates the Confirm state.
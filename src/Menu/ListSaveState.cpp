@@ -180,7 +180,10 @@ void ListSaveState::saveGame()
 			}
 			std::string oldPath = Options::getMasterUserFolder() + oldFilename;
 			std::string newPath = Options::getMasterUserFolder() + newFilename + ".sav";
-			CrossPlatform::moveFile(oldPath, newPath);
+			if (CrossPlatform::moveFile(oldPath, newPath))
+			{
+				SavedGame::removeFromSaveIndex(oldFilename);
+			}
 		}
 	}
 	else
@@ -30,6 +30,7 @@
 #include "ErrorMessageState.h"
 #include "MainMenuState.h"
 #include "../Savegame/SavedGame.h"
+#include "../Savegame/AsyncSave.h"
 #include "../Mod/Mod.h"
 #include "../Mod/RuleInterface.h"
 
@@ -168,13 +169,22 @@ void SaveGameState::think()
 		// Save the game
 		try
 		{
-			std::string backup = _filename + ".bak";
-			_game->getSavedGame()->save(backup, _game->getMod());
-			std::string fullPath = Options::getMasterUserFolder() + _filename;
-			std::string bakPath = Options::getMasterUserFolder() + backup;
-			if (!CrossPlatform::moveFile(bakPath, fullPath))
+			if (Options::oxceAsyncSaves && (_type == SAVE_AUTO_GEOSCAPE || _type == SAVE_AUTO_BATTLESCAPE || _type == SAVE_IRONMAN))
 			{
-				throw Exception("Save backed up in " + backup);
+				// written in the background, failures are logged
+				AsyncSave::start(_game->getSavedGame(), _game->getMod(), _filename);
+			}
+			else
+			{
+				std::string backup = _filename + ".bak";
+				_game->getSavedGame()->save(backup, _game->getMod());
+				std::string fullPath = Options::getMasterUserFolder() + _filename;
+				std::string bakPath = Options::getMasterUserFolder() + backup;
+				if (!CrossPlatform::moveFile(bakPath, fullPath))
+				{
+					throw Exception("Save backed up in " + backup);
+				}
+				_game->getSavedGame()->updateSaveIndex(_filename);
 			}
 
 			if (_type == SAVE_IRONMAN_END)
@@ -168,6 +168,53 @@ bool ExtraSprites::isImageFile(const std::string &filename)
 	return false;
 }
 
+/**
+ * Gets the image files in a folder, in the order they are loaded.
+ * @param folder Folder name, ending with a slash.
+ * @return Sorted image filenames, relative to the folder.
+ */
+std::vector<std::string> ExtraSprites::getFolderImages(const std::string &folder)
+{
+	std::vector<std::string> contents;
+	for (const auto& f : FileMap::getVFolderContents(folder))
+	{
+		if (isImageFile(f))
+		{
+			contents.push_back(f);
+		}
+	}
+	std::sort(contents.begin(), contents.end(), Unicode::naturalCompare);
+	return contents;
+}
+
+/**
+ * Gets all the image files this sprite pack loads,
+ * so they can be decoded ahead of time.
+ * @param files List to add the filenames to.
+ */
+void ExtraSprites::getImageFiles(std::vector<std::string> &files) const
+{
+	for (const auto& pair : _sprites)
+	{
+		const auto& fileName = pair.second;
+		if (!_singleImage && fileName[fileName.length() - 1] == '/')
+		{
+			for (const auto& name : getFolderImages(fileName))
+			{
+				files.push_back(fileName + name);
+			}
+		}
+		else
+		{
+			files.push_back(fileName);
+		}
+		if (_singleImage)
+		{
+			break;
+		}
+	}
+}
+
 /**
  * Loads the external sprite into a new or existing surface.
  * @param surface Existing surface.
@@ -232,13 +279,8 @@ SurfaceSet *ExtraSprites::loadSurfaceSet(SurfaceSet *set)
 		{
 			Log(LOG_VERBOSE) << "Loading surface set from folder: " << fileName << " starting at frame: " << startFrame;
 			int offset = startFrame;
-			std::vector<std::string> contents;
-			for (const auto& f: FileMap::getVFolderContents(fileName)) { contents.push_back(f); }
-			std::sort(contents.begin(), contents.end(), Unicode::naturalCompare);
-			for (const auto& name : contents)
+			for (const auto& name : getFolderImages(fileName))
 			{
-				if (!isImageFile(name))
-					continue;
 				try
 				{
 					getFrame(set, offset)->loadImage(fileName + name);
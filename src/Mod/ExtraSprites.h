@@ -43,6 +43,8 @@ private:
 	bool _loaded;
 
 	Surface *getFrame(SurfaceSet *set, int index) const;
+	/// Gets the sorted image files in a folder.
+	static std::vector<std::string> getFolderImages(const std::string &folder);
 public:
 	/// Creates a blank external sprite set.
 	ExtraSprites();
@@ -66,8 +68,12 @@ public:
 	int getSubY() const;
 	/// Has this sprite been loaded?
 	bool isLoaded() const;
+	/// Marks this sprite to be loaded again when next requested.
+	void unload() { _loaded = false; }
 	/// Checks if a filename is a valid image file.
 	static bool isImageFile(const std::string &filename);
+	/// Gets all the image files loaded by this sprite pack.
+	void getImageFiles(std::vector<std::string> &files) const;
 	/// Load the external sprite into a surface.
 	Surface *loadSurface(Surface *surface);
 	/// Load the external sprite into a surface set.
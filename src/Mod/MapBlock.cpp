@@ -18,9 +18,11 @@
  */
 #include <sstream>
 #include <algorithm>
+#include <iterator>
 #include "MapBlock.h"
 #include "../Battlescape/Position.h"
 #include "../Engine/Exception.h"
+#include "../Engine/FileMap.h"
 
 namespace YAML
 {
@@ -203,4 +205,49 @@ const std::map<std::string, std::pair<int, int> > *MapBlock::getItemsFuseTimers(
 	return &_itemsFuseTimer;
 }
 
+/**
+ * Reads the whole content of a file.
+ * @param filename Path of the file in the virtual file system.
+ * @param data Buffer for the content.
+ */
+static void readWholeFile(const std::string &filename, std::vector<unsigned char> &data)
+{
+	auto file = FileMap::getIStream(filename);
+	data.assign(std::istreambuf_iterator<char>(*file), std::istreambuf_iterator<char>());
+	if (file->bad())
+	{
+		throw Exception("Failed to read file: " + filename);
+	}
+}
+
+/**
+ * Gets the content of the MAP file of this block.
+ * The file is read on the first use and kept for the next missions that use the same terrain.
+ * @return Raw content of the file.
+ */
+const std::vector<unsigned char> &MapBlock::getMapFile()
+{
+	if (!_mapFileLoaded)
+	{
+		readWholeFile("MAPS/" + _name + ".MAP", _mapFile);
+		_mapFileLoaded = true;
+	}
+	return _mapFile;
+}
+
+/**
+ * Gets the content of the RMP file of this block.
+ * The file is read on the first use and kept for the next missions that use the same terrain.
+ * @return Raw content of the file.
+ */
+const std::vector<unsigned char> &MapBlock::getRouteFile()
+{
+	if (!_routeFileLoaded)
+	{
+		readWholeFile("ROUTES/" + _name + ".RMP", _routeFile);
+		_routeFileLoaded = true;
+	}
+	return _routeFile;
+}
+
 }
@@ -52,6 +52,8 @@ private:
 	std::map<std::string, std::vector<Position> > _items;
 	std::vector<RandomizedItems> _randomizedItems;
 	std::map<std::string, std::pair<int, int> > _itemsFuseTimer;
+	std::vector<unsigned char> _mapFile, _routeFile;
+	bool _mapFileLoaded = false, _routeFileLoaded = false;
 public:
 	MapBlock(const std::string &name);
 	~MapBlock();
@@ -77,6 +79,10 @@ public:
 	const std::vector<RandomizedItems> *getRandomizedItems() const;
 	/// Gets the fuse timer for any items that belong in this map block.
 	const std::map<std::string, std::pair<int, int> > *getItemsFuseTimers() const;
+	/// Gets the content of the mapblock's MAP file.
+	const std::vector<unsigned char> &getMapFile();
+	/// Gets the content of the mapblock's RMP file.
+	const std::vector<unsigned char> &getRouteFile();
 
 };
 
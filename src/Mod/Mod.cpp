@@ -39,8 +39,11 @@
 #include "../Engine/ShaderDraw.h"
 #include "../Engine/ShaderMove.h"
 #include "../Engine/Exception.h"
+#include "../Engine/Parallel.h"
+#include "RulesetCache.h"
 #include "../Engine/Logger.h"
 #include "../Engine/ScriptBind.h"
+#include "../Engine/ScriptProfiler.h"
 #include "../Engine/Collections.h"
 #include "SoundDefinition.h"
 #include "ExtraSprites.h"
@@ -165,6 +168,9 @@ const std::string ModNameCurrent = "current";
 /// Reduction of size allocated for transparency LUTs.
 const size_t ModTransparencySizeReduction = 100;
 
+/// Name of the parsed rulesets cache in the user folder.
+const std::string RulesetCacheFile = "rulesets.cache";
+
 void Mod::resetGlobalStatics()
 {
 	DOOR_OPEN = 3;
@@ -344,7 +350,7 @@ public:
  * Creates an empty mod.
  */
 Mod::Mod() :
-	_inventoryOverlapsPaperdoll(false),
+	_inventoryOverlapsPaperdoll(false), _rulesetCacheUsed(false),
 	_maxViewDistance(20), _maxDarknessToSeeUnits(9), _maxStaticLightDistance(16), _maxDynamicLightDistance(24), _enhancedLighting(0),
 	_costHireEngineer(0), _costHireScientist(0),
 	_costEngineer(0), _costScientist(0), _timePersonnel(0), _hireByCountryOdds(0), _hireByRegionOdds(0), _initialFunding(0),
@@ -788,10 +794,28 @@ void Mod::lazyLoadSurface(const std::string &name)
 		auto i = _extraSprites.find(name);
 		if (i != _extraSprites.end())
 		{
+			// big sprite sets are spread over many files, decode them all at once
+			std::vector<std::string> files;
+			for (auto* extraSprites : i->second)
+			{
+				if (!extraSprites->isLoaded())
+				{
+					extraSprites->getImageFiles(files);
+				}
+			}
+			bool preload = files.size() > 1 && !Surface::hasPreloadedImages();
+			if (preload)
+			{
+				Surface::preloadImages(files);
+			}
 			for (auto* extraSprites : i->second)
 			{
 				loadExtraSprite(extraSprites);
 			}
+			if (preload)
+			{
+				Surface::clearPreloadedImages();
+			}
 		}
 	}
 }
@@ -804,9 +828,73 @@ void Mod::lazyLoadSurface(const std::string &name)
 Surface *Mod::getSurface(const std::string &name, bool error)
 {
 	lazyLoadSurface(name);
+	if (Options::lazyLoadResources && Options::oxceSurfaceCacheSize > 0 && _pinnedSurfaces.insert(name).second)
+	{
+		// someone can now keep this pointer, it can't be freed anymore
+		_transientSurfaces.remove(name);
+	}
 	return getRule(name, "Sprite", _surfaces, error);
 }
 
+/**
+ * Returns a specific surface from the mod, that the caller
+ * only uses right away (eg. copies it to its own background).
+ * Big images only seen in a few places (like Ufopaedia pictures)
+ * can then be freed later and loaded again when needed.
+ * @param name Name of the surface.
+ * @return Pointer to the surface, valid until the next call.
+ */
+Surface *Mod::getTransientSurface(const std::string &name, bool error)
+{
+	lazyLoadSurface(name);
+	Surface *surface = getRule(name, "Sprite", _surfaces, error);
+	if (surface && Options::lazyLoadResources && Options::oxceSurfaceCacheSize > 0 &&
+		_pinnedSurfaces.find(name) == _pinnedSurfaces.end() && _extraSprites.find(name) != _extraSprites.end())
+	{
+		_transientSurfaces.remove(name);
+		_transientSurfaces.push_front(name);
+		evictSurfaces(name);
+	}
+	return surface;
+}
+
+/**
+ * Frees the least recently used transient surfaces
+ * until they fit in the memory budget again.
+ * They are loaded again from their sprite packs when next requested.
+ * @param keep Name of the surface that must stay loaded.
+ */
+void Mod::evictSurfaces(const std::string &keep)
+{
+	const size_t budget = (size_t)Options::oxceSurfaceCacheSize * 1024 * 1024;
+	size_t total = 0;
+	for (const auto& name : _transientSurfaces)
+	{
+		auto i = _surfaces.find(name);
+		if (i != _surfaces.end())
+		{
+			total += (size_t)i->second->getWidth() * i->second->getHeight();
+		}
+	}
+	while (total > budget && !_transientSurfaces.empty() && _transientSurfaces.back() != keep)
+	{
+		const std::string name = _transientSurfaces.back();
+		_transientSurfaces.pop_back();
+		auto i = _surfaces.find(name);
+		if (i != _surfaces.end())
+		{
+			Log(LOG_VERBOSE) << "Freeing image: " << name;
+			total -= (size_t)i->second->getWidth() * i->second->getHeight();
+			delete i->second;
+			_surfaces.erase(i);
+		}
+		for (auto* extraSprites : _extraSprites[name])
+		{
+			extraSprites->unload();
+		}
+	}
+}
+
 /**
  * Returns a specific surface set from the mod.
  * @param name Name of the surface set.
@@ -928,9 +1016,38 @@ void Mod::playMusic(const std::string &name, int id)
  */
 SoundSet *Mod::getSoundSet(const std::string &name, bool error) const
 {
+	lazyLoadSound(name);
 	return getRule(name, "Sound Set", _sounds, error);
 }
 
+/**
+ * Loads any extra sounds associated to a sound set when
+ * it's first requested.
+ * @param name Sound set name.
+ */
+void Mod::lazyLoadSound(const std::string &name) const
+{
+	auto i = _pendingExtraSounds.find(name);
+	if (i != _pendingExtraSounds.end())
+	{
+		// take them out first, so a failed load isn't repeated on every sound
+		std::vector<ExtraSounds*> packs;
+		packs.swap(i->second);
+		_pendingExtraSounds.erase(i);
+
+		for (auto* soundPack : packs)
+		{
+			SoundSet *set = 0;
+			auto search = _sounds.find(name);
+			if (search != _sounds.end())
+			{
+				set = search->second;
+			}
+			_sounds[name] = soundPack->loadSoundSet(set);
+		}
+	}
+}
+
 /**
  * Returns a specific sound from the mod.
  * @param set Name of the sound set.
@@ -1071,6 +1188,12 @@ void Mod::verifySoundOffset(const std::string &parent, const int& sound, const s
 		return;
 	}
 
+	if (_pendingExtraSounds.find(set) != _pendingExtraSounds.end())
+	{
+		// not loaded yet, checking it would defeat lazy loading
+		return;
+	}
+
 	auto* s = getSoundSet(set);
 
 	checkForSoftError(sound != Mod::NO_SOUND && s->getSound(sound) == nullptr, parent, "Wrong index " + std::to_string(sound) + " for sound set " + set, LOG_ERROR);
@@ -1087,6 +1210,12 @@ void Mod::verifySoundOffset(const std::string &parent, const std::vector<int>& s
 		return;
 	}
 
+	if (_pendingExtraSounds.find(set) != _pendingExtraSounds.end())
+	{
+		// not loaded yet, checking it would defeat lazy loading
+		return;
+	}
+
 	auto* s = getSoundSet(set);
 
 	for (int sound : sounds)
@@ -2005,6 +2134,12 @@ void Mod::loadAll()
 	{
 		Log(LOG_WARNING) << "Validation of mod data reduced, game can behave incorrectly";
 	}
+	if (Options::oxceScriptProfiler)
+	{
+		// statistics of the old scripts would be lost with them
+		ScriptProfiler::report();
+		ScriptProfiler::clear();
+	}
 	_scriptGlobal->beginLoad();
 	_modData.clear();
 	_modData.resize(mods.size());
@@ -2062,6 +2197,9 @@ void Mod::loadAll()
 	_soundOffsetBattle = _sounds["BATTLE.CAT"]->getMaxSharedSounds();
 	_soundOffsetGeo = _sounds["GEO.CAT"]->getMaxSharedSounds();
 
+	Log(LOG_INFO) << "Parsing rulesets...";
+	auto parsedFiles = parseRuleFiles(mods, _rulesetCacheUsed);
+
 	Log(LOG_INFO) << "Loading rulesets...";
 	// load rest rulesets
 	for (size_t i = 0; mods.size() > i; ++i)
@@ -2070,7 +2208,9 @@ void Mod::loadAll()
 		{
 			_modCurrent = &_modData.at(i);
 			_scriptGlobal->setMod((int)_modCurrent->offset);
-			loadMod(mods[i].second, parser);
+			ScriptProfiler::setMod(_modCurrent->name);
+			loadMod(mods[i].second, parsedFiles[i], parser);
+			parsedFiles[i].clear();
 		}
 		catch (Exception &e)
 		{
@@ -2293,22 +2433,130 @@ void Mod::loadAll()
 
 	sortLists();
 	modResources();
+
+	auto io = FileMap::getIOStats();
+	Log(LOG_INFO) << "Files read: " << (io.bytesMapped + io.bytesRead) / 1024 << " KB (" << io.bytesMapped / 1024 << " KB mapped), "
+		<< io.bytesInflated / 1024 << " KB unzipped in " << io.inflateMicros / 1000 << " ms, "
+		<< io.cacheHits << " of " << io.cacheHits + io.cacheMisses << " zip reads from cache";
+}
+
+/**
+ * Parses the ruleset files of all mods ahead of loading them.
+ * Files are read on the main thread, as zip archives can't be shared
+ * between threads, then the YAML is parsed on worker threads.
+ * Errors are kept and reported when the file would be loaded,
+ * so they show up in the same order and with the same context.
+ * When the ruleset cache matches the files, it's used instead.
+ * @param mods Ruleset files of all mods.
+ * @param fromCache Set if the documents come from the ruleset cache.
+ * @return Parsed files, in the same order as the ruleset files.
+ */
+std::vector<std::vector<Mod::ParsedRuleFile>> Mod::parseRuleFiles(const FileMap::RSOrder &mods, bool &fromCache)
+{
+	std::vector<std::vector<ParsedRuleFile>> parsed(mods.size());
+	fromCache = false;
+
+	std::string cacheFile = Options::getMasterUserFolder() + RulesetCacheFile;
+	uint64_t cacheKey = 0;
+	if (Options::oxceRulesetCache)
+	{
+		cacheKey = RulesetCache::getKey(mods);
+		std::vector<std::vector<YAML::Node>> docs;
+		if (!Options::getRebuildModCache() && RulesetCache::load(cacheFile, cacheKey, mods, docs))
+		{
+			Log(LOG_INFO) << "Using ruleset cache " << cacheFile;
+			for (size_t i = 0; i < mods.size(); ++i)
+			{
+				parsed[i].resize(docs[i].size());
+				for (size_t j = 0; j < docs[i].size(); ++j)
+				{
+					parsed[i][j].doc = docs[i][j];
+				}
+			}
+			fromCache = true;
+			return parsed;
+		}
+		Options::expendRebuildModCache();
+	}
+
+	std::vector<std::pair<ParsedRuleFile*, std::string>> work;
+	for (size_t i = 0; i < mods.size(); ++i)
+	{
+		parsed[i].resize(mods[i].second.size());
+		for (size_t j = 0; j < mods[i].second.size(); ++j)
+		{
+			ParsedRuleFile *file = &parsed[i][j];
+			try
+			{
+				auto stream = mods[i].second[j].getIStream();
+				std::ostringstream text;
+				text << stream->rdbuf();
+				work.push_back(std::make_pair(file, text.str()));
+			}
+			catch (...)
+			{
+				file->error = std::current_exception();
+			}
+		}
+	}
+
+	Parallel::forEach(work.size(), [&](size_t i)
+	{
+		try
+		{
+			work[i].first->doc = YAML::Load(work[i].second);
+		}
+		catch (...)
+		{
+			work[i].first->error = std::current_exception();
+		}
+		std::string().swap(work[i].second);
+	});
+
+	if (Options::oxceRulesetCache)
+	{
+		std::vector<std::vector<YAML::Node>> docs(mods.size());
+		for (size_t i = 0; i < mods.size(); ++i)
+		{
+			for (const auto& file : parsed[i])
+			{
+				if (file.error)
+				{
+					// only complete sets of files are cached
+					return parsed;
+				}
+				docs[i].push_back(file.doc);
+			}
+		}
+		RulesetCache::save(cacheFile, cacheKey, docs);
+	}
+
+	return parsed;
 }
 
 /**
  * Loads a list of rulesets from YAML files for the mod at the specified index. The first
  * mod loaded should be the master at index 0, then 1, and so on.
  * @param rulesetFiles List of rulesets to load.
+ * @param parsedFiles Parsed rulesets, released as they are loaded.
  * @param parsers Object with all available parsers.
  */
-void Mod::loadMod(const std::vector<FileMap::FileRecord> &rulesetFiles, ModScript &parsers)
+void Mod::loadMod(const std::vector<FileMap::FileRecord> &rulesetFiles, std::vector<ParsedRuleFile> &parsedFiles, ModScript &parsers)
 {
-	for (const auto& filerec : rulesetFiles)
+	for (size_t i = 0; i < rulesetFiles.size(); ++i)
 	{
+		const auto& filerec = rulesetFiles[i];
 		Log(LOG_VERBOSE) << "- " << filerec.fullpath;
 		try
 		{
-			loadFile(filerec, parsers);
+			if (parsedFiles[i].error)
+			{
+				Log(LOG_FATAL) << "Error loading file '" << filerec.fullpath << "'";
+				std::rethrow_exception(parsedFiles[i].error);
+			}
+			loadFile(parsedFiles[i].doc, parsers);
+			// the document is not needed anymore
+			parsedFiles[i].doc = YAML::Node();
 		}
 		catch (Exception &e)
 		{
@@ -2532,14 +2780,13 @@ void Mod::loadConstants(const YAML::Node &node)
 }
 
 /**
- * Loads a ruleset's contents from a YAML file.
+ * Loads a ruleset's contents from a parsed YAML file.
  * Rules that match pre-existing rules overwrite them.
- * @param filename YAML filename.
+ * @param doc YAML document of the file.
  * @param parsers Object with all available parsers.
  */
-void Mod::loadFile(const FileMap::FileRecord &filerec, ModScript &parsers)
+void Mod::loadFile(YAML::Node &doc, ModScript &parsers)
 {
-	auto doc = filerec.getYAML();
 
 	if (const YAML::Node &extended = doc["extended"])
 	{
@@ -5777,29 +6024,47 @@ void Mod::loadExtraResources()
 	if (!Options::lazyLoadResources)
 	{
 		Log(LOG_INFO) << "Loading extra resources from ruleset...";
+		// decode the images in batches on all threads, then install them in ruleset order
+		const size_t batchSize = 512;
+		std::vector<ExtraSprites*> packs;
 		for (auto& pair : _extraSprites)
 		{
 			for (auto* extraSprites : pair.second)
 			{
-				loadExtraSprite(extraSprites);
+				packs.push_back(extraSprites);
 			}
 		}
+		for (size_t begin = 0; begin < packs.size();)
+		{
+			std::vector<std::string> files;
+			size_t end = begin;
+			while (end < packs.size() && (end == begin || files.size() < batchSize))
+			{
+				packs[end]->getImageFiles(files);
+				++end;
+			}
+			Surface::preloadImages(files);
+			for (size_t j = begin; j < end; ++j)
+			{
+				loadExtraSprite(packs[j]);
+			}
+			Surface::clearPreloadedImages();
+			begin = end;
+		}
 	}
 
 	if (!Options::mute)
 	{
 		for (const auto& pair : _extraSounds)
 		{
-			const auto& setName = pair.first;
-			ExtraSounds *soundPack = pair.second;
-			SoundSet *set = 0;
-
-			auto search = _sounds.find(setName);
-			if (search != _sounds.end())
+			_pendingExtraSounds[pair.first].push_back(pair.second);
+		}
+		if (!Options::lazyLoadResources)
+		{
+			for (const auto& pair : _extraSounds)
 			{
-				set = search->second;
+				lazyLoadSound(pair.first);
 			}
-			_sounds[setName] = soundPack->loadSoundSet(set);
 		}
 	}
 
@@ -19,10 +19,13 @@
  */
 #include <map>
 #include <unordered_map>
+#include <list>
+#include <set>
 #include <vector>
 #include <string>
 #include <bitset>
 #include <array>
+#include <exception>
 #include <SDL.h>
 #include <yaml-cpp/yaml.h>
 #include "../Engine/Options.h"
@@ -159,7 +162,7 @@ private:
 	std::map<std::string, Font*> _fonts;
 	std::map<std::string, Surface*> _surfaces;
 	std::map<std::string, SurfaceSet*> _sets;
-	std::map<std::string, SoundSet*> _sounds;
+	mutable std::map<std::string, SoundSet*> _sounds;
 	std::map<std::string, Music*> _musics;
 	std::vector<Uint16> _voxelData;
 	std::vector<std::vector<Uint8> > _transparencyLUTs;
@@ -185,6 +188,7 @@ private:
 	std::map<std::string, ArticleDefinition*> _ufopaediaArticles;
 	std::map<std::string, RuleInventory*> _invs;
 	bool _inventoryOverlapsPaperdoll;
+	bool _rulesetCacheUsed;
 	std::map<std::string, RuleResearch *> _research;
 	std::map<std::string, RuleManufacture *> _manufacture;
 	std::map<std::string, RuleManufactureShortcut *> _manufactureShortcut;
@@ -205,6 +209,9 @@ private:
 	std::map<std::string, std::vector<ExtraSprites *> > _extraSprites;
 	std::map<std::string, CustomPalettes *> _customPalettes;
 	std::vector<std::pair<std::string, ExtraSounds *> > _extraSounds;
+	mutable std::map<std::string, std::vector<ExtraSounds *> > _pendingExtraSounds;
+	std::list<std::string> _transientSurfaces;
+	std::set<std::string> _pinnedSurfaces;
 	std::map<std::string, ExtraStrings *> _extraStrings;
 	std::vector<StatString*> _statStrings;
 	std::vector<RuleDamageType*> _damageTypes;
@@ -329,8 +336,17 @@ private:
 	/// Loads a ruleset from a YAML file that have basic resources configuration.
 	void loadResourceConfigFile(const FileMap::FileRecord &filerec);
 	void loadConstants(const YAML::Node &node);
-	/// Loads a ruleset from a YAML file.
-	void loadFile(const FileMap::FileRecord &filerec, ModScript &parsers);
+	/// Loads a ruleset from a parsed YAML file.
+	void loadFile(YAML::Node &doc, ModScript &parsers);
+
+	/// Ruleset file parsed ahead of loading, or the error it failed with.
+	struct ParsedRuleFile
+	{
+		YAML::Node doc;
+		std::exception_ptr error;
+	};
+	/// Parses the ruleset files of all mods on worker threads.
+	static std::vector<std::vector<ParsedRuleFile>> parseRuleFiles(const FileMap::RSOrder &mods, bool &fromCache);
 
 	template<typename T>
 	struct RuleFactory
@@ -363,13 +379,17 @@ private:
 	/// Creates a transparency lookup table for a given palette.
 	void createTransparencyLUT(Palette *pal);
 	/// Loads a specified mod content.
-	void loadMod(const std::vector<FileMap::FileRecord> &rulesetFiles, ModScript &parsers);
+	void loadMod(const std::vector<FileMap::FileRecord> &rulesetFiles, std::vector<ParsedRuleFile> &parsedFiles, ModScript &parsers);
 	/// Loads resources from vanilla.
 	void loadVanillaResources();
 	/// Loads resources from extra rulesets.
 	void loadExtraResources();
 	/// Loads surfaces on demand.
 	void lazyLoadSurface(const std::string &name);
+	/// Loads sounds on demand.
+	void lazyLoadSound(const std::string &name) const;
+	/// Frees transient surfaces over the memory budget.
+	void evictSurfaces(const std::string &keep);
 	/// Loads an external sprite.
 	void loadExtraSprite(ExtraSprites *spritePack);
 	/// Applies mods to vanilla resources.
@@ -456,6 +476,8 @@ public:
 	Surface *getSurface(const std::string &name, bool error = true);
 	/// Gets a particular surface set.
 	SurfaceSet *getSurfaceSet(const std::string &name, bool error = true);
+	/// Gets a particular surface that can be freed once it's no longer used.
+	Surface *getTransientSurface(const std::string &name, bool error = true);
 	/// Gets a particular music.
 	Music *getMusic(const std::string &name, bool error = true) const;
 	/// Gets the available music tracks.
@@ -770,6 +792,8 @@ public:
 
 	/// Gets whether or not the inventory slots overlap with the paperdoll button
 	bool getInventoryOverlapsPaperdoll() const { return _inventoryOverlapsPaperdoll; }
+	/// Gets whether rulesets were loaded from the ruleset cache, whose documents have no line numbers.
+	bool isRulesetCacheUsed() const { return _rulesetCacheUsed; }
 	/// Gets max view distance in BattleScape.
 	int getMaxViewDistance() const { return _maxViewDistance; }
 	/// Gets threshold of darkness for LoS calculation.
@@ -0,0 +1,353 @@
+/*
+ * Copyright 2010-2023 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "RulesetCache.h"
+#include <cstring>
+#include <SDL_rwops.h>
+#include "../version.h"
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/Exception.h"
+#include "../Engine/Logger.h"
+#include "../Engine/Parallel.h"
+
+namespace OpenXcom
+{
+
+namespace RulesetCache
+{
+
+namespace
+{
+
+const char CacheMagic[4] = { 'O', 'X', 'R', 'C' };
+const uint32_t CacheVersion = 1;
+
+enum CacheNodeType : uint8_t { CACHE_NULL, CACHE_SCALAR, CACHE_SEQUENCE, CACHE_MAP };
+
+/**
+ * Mixes bytes into a FNV-1a hash.
+ */
+void hash(uint64_t &h, const void *data, size_t size)
+{
+	const unsigned char *p = (const unsigned char*)data;
+	for (size_t i = 0; i < size; ++i)
+	{
+		h ^= p[i];
+		h *= 1099511628211ULL;
+	}
+}
+
+void hash(uint64_t &h, const std::string &s)
+{
+	hash(h, s.data(), s.size() + 1);
+}
+
+void hash(uint64_t &h, uint64_t v)
+{
+	hash(h, &v, sizeof(v));
+}
+
+void writeInt(std::string &out, uint64_t v, int bytes)
+{
+	for (int i = 0; i < bytes; ++i)
+	{
+		out.push_back((char)((v >> (8 * i)) & 0xFF));
+	}
+}
+
+void writeString(std::string &out, const std::string &s)
+{
+	writeInt(out, s.size(), 4);
+	out.append(s);
+}
+
+/**
+ * Appends a node and all its children to the buffer.
+ */
+void writeNode(std::string &out, const YAML::Node &node)
+{
+	switch (node.Type())
+	{
+	case YAML::NodeType::Scalar:
+		writeInt(out, CACHE_SCALAR, 1);
+		writeString(out, node.Tag());
+		writeString(out, node.Scalar());
+		break;
+	case YAML::NodeType::Sequence:
+		writeInt(out, CACHE_SEQUENCE, 1);
+		writeString(out, node.Tag());
+		writeInt(out, node.size(), 4);
+		for (const auto& child : node)
+		{
+			writeNode(out, child);
+		}
+		break;
+	case YAML::NodeType::Map:
+		writeInt(out, CACHE_MAP, 1);
+		writeString(out, node.Tag());
+		writeInt(out, node.size(), 4);
+		for (const auto& pair : node)
+		{
+			writeNode(out, pair.first);
+			writeNode(out, pair.second);
+		}
+		break;
+	default:
+		writeInt(out, CACHE_NULL, 1);
+		writeString(out, node.IsDefined() ? node.Tag() : "");
+		break;
+	}
+}
+
+/**
+ * Reads values from a part of the cache file.
+ * Every read is bounds checked, a corrupted cache throws.
+ */
+struct CacheReader
+{
+	const char *pos, *end;
+
+	uint64_t readInt(int bytes)
+	{
+		if (end - pos < bytes)
+		{
+			throw Exception("Ruleset cache is truncated");
+		}
+		uint64_t v = 0;
+		for (int i = 0; i < bytes; ++i)
+		{
+			v |= (uint64_t)(unsigned char)pos[i] << (8 * i);
+		}
+		pos += bytes;
+		return v;
+	}
+
+	std::string readString()
+	{
+		uint64_t size = readInt(4);
+		if ((uint64_t)(end - pos) < size)
+		{
+			throw Exception("Ruleset cache is truncated");
+		}
+		std::string s(pos, size);
+		pos += size;
+		return s;
+	}
+
+	YAML::Node readNode()
+	{
+		uint8_t type = readInt(1);
+		std::string tag = readString();
+		YAML::Node node;
+		switch (type)
+		{
+		case CACHE_SCALAR:
+			node = YAML::Node(readString());
+			break;
+		case CACHE_SEQUENCE:
+		{
+			node = YAML::Node(YAML::NodeType::Sequence);
+			uint64_t count = readInt(4);
+			for (uint64_t i = 0; i < count; ++i)
+			{
+				node.push_back(readNode());
+			}
+			break;
+		}
+		case CACHE_MAP:
+		{
+			node = YAML::Node(YAML::NodeType::Map);
+			uint64_t count = readInt(4);
+			for (uint64_t i = 0; i < count; ++i)
+			{
+				YAML::Node key = readNode();
+				node.force_insert(key, readNode());
+			}
+			break;
+		}
+		case CACHE_NULL:
+			node = YAML::Node(YAML::NodeType::Null);
+			break;
+		default:
+			throw Exception("Ruleset cache is corrupted");
+		}
+		if (!tag.empty())
+		{
+			node.SetTag(tag);
+		}
+		return node;
+	}
+};
+
+}
+
+/**
+ * Computes the key identifying the ruleset files, from the engine
+ * version and the name and contents stamp of every file of every mod.
+ * @param mods Ruleset files of all mods.
+ * @return Cache key.
+ */
+uint64_t getKey(const FileMap::RSOrder &mods)
+{
+	uint64_t h = 14695981039346656037ULL;
+	hash(h, CacheVersion);
+	hash(h, OPENXCOM_VERSION_LONG);
+	hash(h, OPENXCOM_VERSION_GIT);
+	for (const auto& mod : mods)
+	{
+		hash(h, mod.first);
+		hash(h, mod.second.size());
+		for (const auto& filerec : mod.second)
+		{
+			hash(h, filerec.fullpath);
+			hash(h, filerec.getStamp());
+		}
+	}
+	return h;
+}
+
+/**
+ * Loads the cached documents if the cache exists and matches the key.
+ * @param filename Full path of the cache.
+ * @param key Expected cache key.
+ * @param mods Ruleset files of all mods.
+ * @param docs Documents for every file of every mod.
+ * @return True if the cache was used.
+ */
+bool load(const std::string &filename, uint64_t key, const FileMap::RSOrder &mods, std::vector<std::vector<YAML::Node>> &docs)
+{
+	if (!CrossPlatform::fileExists(filename))
+	{
+		return false;
+	}
+	SDL_RWops *file = SDL_RWFromFile(filename.c_str(), "rb");
+	if (!file)
+	{
+		return false;
+	}
+	std::string data;
+	Sint64 size = SDL_RWseek(file, 0, RW_SEEK_END);
+	SDL_RWseek(file, 0, RW_SEEK_SET);
+	if (size > 0)
+	{
+		data.resize(size);
+		if (SDL_RWread(file, &data[0], size, 1) != 1)
+		{
+			data.clear();
+		}
+	}
+	SDL_RWclose(file);
+
+	if (data.size() < sizeof(CacheMagic) || memcmp(data.data(), CacheMagic, sizeof(CacheMagic)) != 0)
+	{
+		return false;
+	}
+	try
+	{
+		CacheReader header = { data.data() + sizeof(CacheMagic), data.data() + data.size() };
+		if (header.readInt(4) != CacheVersion || header.readInt(8) != key || header.readInt(4) != mods.size())
+		{
+			return false;
+		}
+
+		// find where each document starts, then rebuild them on worker threads
+		std::vector<std::pair<YAML::Node*, CacheReader>> work;
+		docs.clear();
+		docs.resize(mods.size());
+		for (size_t i = 0; i < mods.size(); ++i)
+		{
+			if (header.readInt(4) != mods[i].second.size())
+			{
+				return false;
+			}
+			docs[i].resize(mods[i].second.size());
+			for (size_t j = 0; j < mods[i].second.size(); ++j)
+			{
+				uint64_t length = header.readInt(8);
+				if ((uint64_t)(header.end - header.pos) < length)
+				{
+					return false;
+				}
+				CacheReader reader = { header.pos, header.pos + length };
+				work.push_back(std::make_pair(&docs[i][j], reader));
+				header.pos += length;
+			}
+		}
+		Parallel::forEach(work.size(), [&](size_t i)
+		{
+			*work[i].first = work[i].second.readNode();
+		});
+	}
+	catch (Exception &e)
+	{
+		Log(LOG_WARNING) << filename << ": " << e.what();
+		docs.clear();
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Saves the documents to the cache, replacing the old one.
+ * @param filename Full path of the cache.
+ * @param key Cache key.
+ * @param docs Documents for every file of every mod.
+ */
+void save(const std::string &filename, uint64_t key, const std::vector<std::vector<YAML::Node>> &docs)
+{
+	std::vector<const YAML::Node*> nodes;
+	for (const auto& mod : docs)
+	{
+		for (const auto& doc : mod)
+		{
+			nodes.push_back(&doc);
+		}
+	}
+	std::vector<std::string> blobs(nodes.size());
+	Parallel::forEach(nodes.size(), [&](size_t i)
+	{
+		writeNode(blobs[i], *nodes[i]);
+	});
+
+	std::string out;
+	out.append(CacheMagic, sizeof(CacheMagic));
+	writeInt(out, CacheVersion, 4);
+	writeInt(out, key, 8);
+	writeInt(out, docs.size(), 4);
+	size_t n = 0;
+	for (const auto& mod : docs)
+	{
+		writeInt(out, mod.size(), 4);
+		for (size_t j = 0; j < mod.size(); ++j, ++n)
+		{
+			writeInt(out, blobs[n].size(), 8);
+			out.append(blobs[n]);
+			std::string().swap(blobs[n]);
+		}
+	}
+
+	std::string temp = filename + ".tmp";
+	if (!CrossPlatform::writeFile(temp, std::vector<unsigned char>(out.begin(), out.end())) || !CrossPlatform::moveFile(temp, filename))
+	{
+		Log(LOG_WARNING) << "Failed to write ruleset cache " << filename;
+	}
+}
+
+}
+
+}
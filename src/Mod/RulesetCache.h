@@ -0,0 +1,45 @@
+#pragma once
+/*
+ * Copyright 2010-2023 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+#include "../Engine/FileMap.h"
+
+namespace OpenXcom
+{
+
+/**
+ * On-disk cache of the parsed ruleset files of all loaded mods.
+ * Documents are stored in a compact binary form that is much
+ * cheaper to rebuild than parsing the YAML text again.
+ * The cache is only valid for the exact same set of files.
+ */
+namespace RulesetCache
+{
+	/// Computes the key identifying the ruleset files.
+	uint64_t getKey(const FileMap::RSOrder &mods);
+	/// Loads the cached documents if they match the key.
+	bool load(const std::string &filename, uint64_t key, const FileMap::RSOrder &mods, std::vector<std::vector<YAML::Node>> &docs);
+	/// Saves the documents to the cache.
+	void save(const std::string &filename, uint64_t key, const std::vector<std::vector<YAML::Node>> &docs);
+}
+
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2010-2023 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "AsyncSave.h"
+#include <atomic>
+#include <SDL_thread.h>
+#include "SavedGame.h"
+#include "../Engine/Exception.h"
+#include "../Engine/Logger.h"
+#include "../Engine/Options.h"
+#include "../Engine/CrossPlatform.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/**
+ * Everything the worker thread needs, owned by the thread while it runs.
+ */
+struct AsyncSaveJob
+{
+	SaveSnapshot snapshot;
+	SaveBrief brief;
+	std::string save, filename, backup;
+	bool binary;
+	int compression;
+	std::string error;
+};
+
+SDL_Thread *saveThread = 0;
+AsyncSaveJob *saveJob = 0;
+std::atomic<bool> saveDone(true);
+
+/**
+ * Writes the snapshot to the backup file and moves it over the real save.
+ * @param data Pointer to the job.
+ * @return 0 on success.
+ */
+int writeJob(void *data)
+{
+	AsyncSaveJob *job = (AsyncSaveJob*)data;
+	try
+	{
+		SavedGame::writeSnapshot(job->snapshot, job->backup, job->binary, job->compression);
+		if (!CrossPlatform::moveFile(job->backup, job->filename))
+		{
+			job->error = "Save backed up in " + job->backup;
+		}
+	}
+	catch (Exception &e)
+	{
+		job->error = e.what();
+	}
+	catch (YAML::Exception &e)
+	{
+		job->error = e.what();
+	}
+	// free the snapshot here instead of on the main thread
+	job->snapshot = SaveSnapshot();
+	saveDone = true;
+	return job->error.empty() ? 0 : 1;
+}
+
+/**
+ * Joins the worker thread and reports the result of the save.
+ * @return True if the save was written.
+ */
+bool finishJob()
+{
+	if (saveThread != 0)
+	{
+		SDL_WaitThread(saveThread, 0);
+		saveThread = 0;
+	}
+	bool ok = true;
+	if (saveJob)
+	{
+		if (!saveJob->error.empty())
+		{
+			Log(LOG_ERROR) << "Failed to save " << saveJob->filename << ": " << saveJob->error;
+			ok = false;
+		}
+		else
+		{
+			SavedGame::updateSaveIndex(saveJob->save, saveJob->brief);
+		}
+		delete saveJob;
+		saveJob = 0;
+	}
+	return ok;
+}
+
+}
+
+/**
+ * Serializes the game and starts writing it in the background.
+ * Waits for the previous save first, so saves never overlap.
+ * @param save Saved game to write.
+ * @param mod Mod for the saved game.
+ * @param filename Save filename, relative to the user folder.
+ */
+void AsyncSave::start(const SavedGame *save, Mod *mod, const std::string &filename)
+{
+	flush();
+
+	saveJob = new AsyncSaveJob();
+	saveJob->save = filename;
+	saveJob->filename = Options::getMasterUserFolder() + filename;
+	saveJob->backup = saveJob->filename + ".bak";
+	saveJob->binary = Options::oxceBinarySaves;
+	saveJob->compression = Options::oxceBinarySaveCompression;
+	save->snapshot(saveJob->snapshot, mod);
+	saveJob->brief = SavedGame::decodeSaveBrief(saveJob->snapshot.brief);
+
+	saveDone = false;
+	saveThread = SDL_CreateThread(writeJob, (void*)saveJob);
+	if (saveThread == 0)
+	{
+		// If we can't create the thread, just save it as usual
+		writeJob((void*)saveJob);
+		finishJob();
+	}
+}
+
+/**
+ * Checks if a save is still being written.
+ * @return True while the worker thread is running.
+ */
+bool AsyncSave::isBusy()
+{
+	return !saveDone;
+}
+
+/**
+ * Joins the worker thread once it's done, so errors
+ * get logged without waiting for the next save.
+ */
+void AsyncSave::think()
+{
+	if (saveJob && saveDone)
+	{
+		finishJob();
+	}
+}
+
+/**
+ * Blocks until the pending save has been written.
+ * Must be called before quitting or touching the save files.
+ * @return True if there was nothing pending or the save succeeded.
+ */
+bool AsyncSave::flush()
+{
+	return finishJob();
+}
+
+}
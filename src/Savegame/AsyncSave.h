@@ -0,0 +1,48 @@
+#pragma once
+/*
+ * Copyright 2010-2023 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+
+namespace OpenXcom
+{
+
+class SavedGame;
+class Mod;
+
+/**
+ * Writes saved games to disk on a background thread.
+ * The game is serialized into a snapshot on the main thread,
+ * the worker then encodes and writes it to a backup file
+ * and renames it over the real save once it's complete.
+ * Only one save is in flight at a time.
+ */
+class AsyncSave
+{
+public:
+	/// Starts saving a game in the background.
+	static void start(const SavedGame *save, Mod *mod, const std::string &filename);
+	/// Checks if a save is still being written.
+	static bool isBusy();
+	/// Cleans up after a finished save.
+	static void think();
+	/// Waits for the pending save to finish.
+	static bool flush();
+};
+
+}
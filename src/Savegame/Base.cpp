@@ -572,7 +572,7 @@ int Base::getAvailableSoldiers(bool checkCombatReadiness, bool includeWounded) c
 		{
 			total++;
 		}
-		else if (checkCombatReadiness && ((soldier->getCraft() != 0 && soldier->getCraft()->getStatus() != "STR_OUT") ||
+		else if (checkCombatReadiness && ((soldier->getCraft() != 0 && soldier->getCraft()->getStatus() != CRAFT_OUT) ||
 			(soldier->getCraft() == 0 && (soldier->hasFullHealth() || (includeWounded && soldier->canDefendBase())))))
 		{
 			total++;
@@ -1108,6 +1108,24 @@ int Base::getLongRangeDetection() const
 	return total;
 }
 
+/**
+ * Returns the largest radar range (normal or hyperwave)
+ * of all completed facilities in the base.
+ * @return Range in nautical miles, 0 if the base has no radar.
+ */
+int Base::getMaxRadarRange() const
+{
+	int range = 0;
+	for (const auto* fac : _facilities)
+	{
+		if (fac->getBuildTime() == 0)
+		{
+			range = std::max(range, fac->getRules()->getRadarRange());
+		}
+	}
+	return range;
+}
+
 /**
  * Returns the total amount of craft of
  * a certain type stored in the base.
@@ -1142,7 +1160,7 @@ int Base::getCraftCountForProduction(const RuleCraft *craft) const
 	int total = 0;
 	for (const auto* xcraft : _crafts)
 	{
-		if (xcraft->getRules() == craft && xcraft->getStatus() != "STR_OUT")
+		if (xcraft->getRules() == craft && xcraft->getStatus() != CRAFT_OUT)
 		{
 			total++;
 		}
@@ -1585,7 +1603,7 @@ void Base::setupDefenses(AlienMission* am)
 	// add vehicles that are in the crafts of the base, if it's not out
 	for (auto* xcraft : _crafts)
 	{
-		if (xcraft->getStatus() != "STR_OUT")
+		if (xcraft->getStatus() != CRAFT_OUT)
 		{
 			for (auto* vehicle : *xcraft->getVehicles())
 			{
@@ -210,6 +210,8 @@ public:
 	int getShortRangeDetection() const;
 	/// Gets the base's long range detection.
 	int getLongRangeDetection() const;
+	/// Gets the base's maximum radar range.
+	int getMaxRadarRange() const;
 	/// Gets the base's crafts of a certain type.
 	int getCraftCount(const RuleCraft *craft) const;
 	/// Gets the base's crafts of a certain type.
@@ -26,6 +26,7 @@
 #include "../Mod/RuleSkill.h"
 #include "../Mod/RuleInventory.h"
 #include "../Engine/Collections.h"
+#include "../Engine/ObjectPool.h"
 #include "../Engine/Surface.h"
 #include "../Engine/SurfaceSet.h"
 #include "../Engine/Script.h"
@@ -95,6 +96,51 @@ BattleItem::~BattleItem()
 {
 }
 
+namespace
+{
+
+/**
+ * Gets the pool that holds memory of all items.
+ */
+ObjectPool<BattleItem>& getItemPool()
+{
+	static ObjectPool<BattleItem> pool;
+	return pool;
+}
+
+}
+
+/**
+ * Allocates memory for the item.
+ * Items are created and deleted all the time during a battle, so they are kept in one pool
+ * instead of being spread over the heap.
+ * @param size Size of the object.
+ * @return Memory for the object.
+ */
+void* BattleItem::operator new(std::size_t size)
+{
+	if (size != sizeof(BattleItem))
+	{
+		return ::operator new(size);
+	}
+	return getItemPool().allocate();
+}
+
+/**
+ * Returns memory of the item to the pool.
+ * @param p Memory of the object.
+ * @param size Size of the object.
+ */
+void BattleItem::operator delete(void* p, std::size_t size)
+{
+	if (size != sizeof(BattleItem))
+	{
+		::operator delete(p);
+		return;
+	}
+	getItemPool().deallocate(p);
+}
+
 /**
  * Loads the item from a YAML file.
  * @param node YAML node.
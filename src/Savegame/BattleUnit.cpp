@@ -26,6 +26,7 @@
 #include "../Engine/ScriptBind.h"
 #include "../Engine/Language.h"
 #include "../Engine/Exception.h"
+#include "../Engine/ObjectPool.h"
 #include "../Engine/Options.h"
 #include "../Engine/RNG.h"
 #include "../Battlescape/Pathfinding.h"
@@ -644,6 +645,51 @@ BattleUnit::~BattleUnit()
 	delete _currentAIState;
 }
 
+namespace
+{
+
+/**
+ * Gets the pool that holds memory of all units.
+ */
+ObjectPool<BattleUnit>& getUnitPool()
+{
+	static ObjectPool<BattleUnit> pool;
+	return pool;
+}
+
+}
+
+/**
+ * Allocates memory for the unit.
+ * Units are created and deleted with every battle and every summon or transformation,
+ * so they are kept in one pool instead of being spread over the heap.
+ * @param size Size of the object.
+ * @return Memory for the object.
+ */
+void* BattleUnit::operator new(std::size_t size)
+{
+	if (size != sizeof(BattleUnit))
+	{
+		return ::operator new(size);
+	}
+	return getUnitPool().allocate();
+}
+
+/**
+ * Returns memory of the unit to the pool.
+ * @param p Memory of the object.
+ * @param size Size of the object.
+ */
+void BattleUnit::operator delete(void* p, std::size_t size)
+{
+	if (size != sizeof(BattleUnit))
+	{
+		::operator delete(p);
+		return;
+	}
+	getUnitPool().deallocate(p);
+}
+
 /**
  * Loads the unit from a YAML file.
  * @param node YAML node.
@@ -970,9 +1016,24 @@ int BattleUnit::distance3dToUnitSq(BattleUnit* otherUnit) const
 void BattleUnit::setPosition(Position pos, bool updateLastPos)
 {
 	if (updateLastPos) { _lastPos = _pos; }
+	if (_unitGrid && _pos != pos)
+	{
+		_unitGrid->moveUnitInGrid(_unitGridIndex, _pos, pos);
+	}
 	_pos = pos;
 }
 
+/**
+ * Sets the battle whose unit grid keeps track of this unit.
+ * @param save Battle or null when unit is not in grid.
+ * @param index Index of unit in battle unit list.
+ */
+void BattleUnit::setUnitGrid(SavedBattleGame *save, int index)
+{
+	_unitGrid = save;
+	_unitGridIndex = index;
+}
+
 /**
  * Gets the BattleUnit's position.
  * @return position
@@ -1188,7 +1249,7 @@ void BattleUnit::keepWalking(SavedBattleGame *savedBattleGame, bool fullWalkCycl
 
 	if (!fullWalkCycle)
 	{
-		_pos = _destination;
+		setPosition(_destination, false);
 		end = 2;
 	}
 
@@ -1198,7 +1259,7 @@ void BattleUnit::keepWalking(SavedBattleGame *savedBattleGame, bool fullWalkCycl
 	{
 		// we assume we reached our destination tile
 		// this is actually a drawing hack, so soldiers are not overlapped by floor tiles
-		_pos = _destination;
+		setPosition(_destination, false);
 	}
 
 	if (!fullWalkCycle || (_walkPhase == middle))
@@ -2379,9 +2440,16 @@ void BattleUnit::clearVisibleUnits()
  */
 bool BattleUnit::addToVisibleTiles(Tile *tile)
 {
+	const auto* save = tile->getSavedGame();
+	const auto index = save->getTileIndex(tile);
+	if (_visibleTilesLookup.size() <= (size_t)index)
+	{
+		_visibleTilesLookup.resize(save->getMapSizeXYZ(), false);
+	}
 	//Only add once, otherwise we're going to mess up the visibility value and make trouble for the AI (if sneaky).
-	if (_visibleTilesLookup.insert(tile).second)
+	if (!_visibleTilesLookup[index])
 	{
+		_visibleTilesLookup[index] = true;
 		tile->setVisible(1);
 		_visibleTiles.push_back(tile);
 		return true;
@@ -2389,6 +2457,17 @@ bool BattleUnit::addToVisibleTiles(Tile *tile)
 	return false;
 }
 
+/**
+ * Has this unit marked this tile as within its view?
+ * @param tile Tile to check.
+ * @return True if tile is in list of visible tiles.
+ */
+bool BattleUnit::hasVisibleTile(const Tile *tile) const
+{
+	const auto index = (size_t)tile->getSavedGame()->getTileIndex(tile);
+	return index < _visibleTilesLookup.size() && _visibleTilesLookup[index];
+}
+
 /**
  * Get the pointer to the vector of visible tiles.
  * @return pointer to vector.
@@ -2406,8 +2485,8 @@ void BattleUnit::clearVisibleTiles()
 	for (auto* tile : _visibleTiles)
 	{
 		tile->setVisible(-1);
+		_visibleTilesLookup[tile->getSavedGame()->getTileIndex(tile)] = false;
 	}
-	_visibleTilesLookup.clear();
 	_visibleTiles.clear();
 }
 
@@ -19,7 +19,6 @@
  */
 #include <vector>
 #include <string>
-#include <unordered_set>
 #include "../Battlescape/Position.h"
 #include "../Mod/Armor.h"
 #include "../Mod/RuleItem.h"
@@ -82,6 +81,8 @@ private:
 	Position _pos;
 	Tile *_tile;
 	Position _lastPos;
+	SavedBattleGame *_unitGrid = nullptr;
+	int _unitGridIndex = -1;
 	int _direction, _toDirection;
 	int _directionTurret, _toDirectionTurret;
 	int _verticalDirection;
@@ -91,7 +92,7 @@ private:
 	int _walkPhase, _fallPhase;
 	std::vector<BattleUnit *> _visibleUnits, _unitsSpottedThisTurn;
 	std::vector<Tile *> _visibleTiles;
-	std::unordered_set<Tile *> _visibleTilesLookup;
+	std::vector<bool> _visibleTilesLookup;
 	int _tu, _energy, _health, _morale, _stunlevel, _mana;
 	bool _kneeled, _floating, _dontReselect;
 	bool _haveNoFloorBelow = false;
@@ -210,6 +211,10 @@ public:
 	void updateArmorFromNonSoldier(const Mod* mod, Armor* newArmor, int depth, const RuleStartingCondition* sc);
 	/// Cleans up the BattleUnit.
 	~BattleUnit();
+	/// Allocates memory for the unit from a pool shared by all units.
+	static void* operator new(std::size_t size);
+	/// Returns memory of the unit to the pool.
+	static void operator delete(void* p, std::size_t size);
 	/// Loads the unit from YAML.
 	void load(const YAML::Node &node, const Mod *mod, const ScriptGlobal *shared);
 	/// Saves the unit to YAML.
@@ -222,6 +227,8 @@ public:
 	int distance3dToUnitSq(BattleUnit* otherUnit) const;
 	/// Sets the unit's position
 	void setPosition(Position pos, bool updateLastPos = true);
+	/// Sets the battle grid that tracks this unit's position.
+	void setUnitGrid(SavedBattleGame *save, int index);
 	/// Gets the unit's position.
 	Position getPosition() const;
 	/// Gets the unit's position.
@@ -355,10 +362,7 @@ public:
 	/// Add unit to visible tiles.
 	bool addToVisibleTiles(Tile *tile);
 	/// Has this unit marked this tile as within its view?
-	bool hasVisibleTile(Tile *tile) const
-	{
-		return _visibleTilesLookup.find(tile) != _visibleTilesLookup.end(); //find?
-	}
+	bool hasVisibleTile(const Tile *tile) const;
 	/// Get the list of visible tiles.
 	const std::vector<Tile*> *getVisibleTiles();
 	/// Clear visible tiles.
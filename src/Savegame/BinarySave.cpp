@@ -0,0 +1,301 @@
+/*
+ * Copyright 2010-2023 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "BinarySave.h"
+#include <cstring>
+#include <SDL_endian.h>
+#include "../Engine/Exception.h"
+#include "../../libs/miniz/miniz.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+const char BinarySaveMagic[4] = { 'O', 'X', 'C', 'S' };
+const uint32_t BinarySaveVersion = 1;
+const uint32_t SectionCompressed = 1;
+
+/// Size of magic, version and section count.
+const int HeaderSize = 12;
+/// Size of one section table entry.
+const int EntrySize = 32;
+/// Largest decompressed section we accept, anything bigger is a corrupted table.
+const uint64_t MaxRawSize = 1ull << 30;
+/// Best case deflate ratio (with some slack), a compressed section can't expand more than that.
+const uint64_t MaxDeflateRatio = 1040;
+
+}
+
+/**
+ * Creates the file and reserves space for the header and section table.
+ * @param filename Full path of the save.
+ * @param compression Deflate level, 0 to store sections uncompressed.
+ */
+BinarySaveWriter::BinarySaveWriter(const std::string &filename, int compression) : _filename(filename), _file(nullptr), _compression(compression)
+{
+	_file = SDL_RWFromFile(filename.c_str(), "wb");
+	if (!_file)
+	{
+		throw Exception("Failed to save " + filename + ": " + SDL_GetError());
+	}
+	std::vector<char> reserved(HeaderSize + EntrySize * SAVE_SECTION_MAX, 0);
+	writeRaw(reserved.data(), reserved.size());
+}
+
+/**
+ * Closes the file if it was not finished.
+ */
+BinarySaveWriter::~BinarySaveWriter()
+{
+	if (_file)
+	{
+		SDL_RWclose(_file);
+	}
+}
+
+/**
+ * Writes a block of bytes at the current position.
+ * @param data Bytes to write.
+ * @param size Number of bytes.
+ */
+void BinarySaveWriter::writeRaw(const void *data, size_t size)
+{
+	if (size > 0 && SDL_RWwrite(_file, data, size, 1) != 1)
+	{
+		throw Exception("Failed to save " + _filename + ": " + SDL_GetError());
+	}
+}
+
+/**
+ * Serializes one section and appends it to the file.
+ * @param id Section ID.
+ * @param node Section contents.
+ */
+void BinarySaveWriter::writeSection(SaveSection id, const YAML::Node &node)
+{
+	YAML::Emitter out;
+	out << node;
+
+	SaveSectionEntry entry;
+	entry.id = id;
+	entry.flags = 0;
+	entry.offset = SDL_RWtell(_file);
+	entry.rawSize = out.size();
+	entry.storedSize = out.size();
+
+	if (_compression > 0)
+	{
+		mz_ulong size = mz_compressBound(out.size());
+		std::vector<unsigned char> buffer(size);
+		if (mz_compress2(buffer.data(), &size, (const unsigned char*)out.c_str(), out.size(), _compression) != MZ_OK)
+		{
+			throw Exception("Failed to compress save section in " + _filename);
+		}
+		entry.flags |= SectionCompressed;
+		entry.storedSize = size;
+		writeRaw(buffer.data(), size);
+	}
+	else
+	{
+		writeRaw(out.c_str(), out.size());
+	}
+	_entries.push_back(entry);
+}
+
+/**
+ * Fills in the header and section table and closes the file.
+ */
+void BinarySaveWriter::finish()
+{
+	SDL_RWseek(_file, 0, RW_SEEK_SET);
+	writeRaw(BinarySaveMagic, sizeof(BinarySaveMagic));
+	SDL_WriteLE32(_file, BinarySaveVersion);
+	SDL_WriteLE32(_file, _entries.size());
+	for (const auto& entry : _entries)
+	{
+		SDL_WriteLE32(_file, entry.id);
+		SDL_WriteLE32(_file, entry.flags);
+		SDL_WriteLE64(_file, entry.offset);
+		SDL_WriteLE64(_file, entry.storedSize);
+		SDL_WriteLE64(_file, entry.rawSize);
+	}
+	if (SDL_RWclose(_file) != 0)
+	{
+		_file = nullptr;
+		throw Exception("Failed to save " + _filename + ": " + SDL_GetError());
+	}
+	_file = nullptr;
+}
+
+/**
+ * Checks the magic bytes at the start of a file.
+ * @param filename Full path of the save.
+ * @return True if it's a binary save, false if it's YAML (or unreadable).
+ */
+bool BinarySaveReader::isBinarySave(const std::string &filename)
+{
+	SDL_RWops *file = SDL_RWFromFile(filename.c_str(), "rb");
+	if (!file)
+	{
+		return false;
+	}
+	char magic[sizeof(BinarySaveMagic)];
+	bool binary = SDL_RWread(file, magic, sizeof(magic), 1) == 1 && memcmp(magic, BinarySaveMagic, sizeof(magic)) == 0;
+	SDL_RWclose(file);
+	return binary;
+}
+
+/**
+ * Opens a binary save and reads its section table.
+ * @param filename Full path of the save.
+ */
+BinarySaveReader::BinarySaveReader(const std::string &filename) : _filename(filename), _file(nullptr)
+{
+	_file = SDL_RWFromFile(filename.c_str(), "rb");
+	if (!_file)
+	{
+		throw Exception("Failed to read " + filename + ": " + SDL_GetError());
+	}
+	char magic[sizeof(BinarySaveMagic)];
+	if (SDL_RWread(_file, magic, sizeof(magic), 1) != 1 || memcmp(magic, BinarySaveMagic, sizeof(magic)) != 0)
+	{
+		SDL_RWclose(_file);
+		throw Exception(filename + " is not a binary save");
+	}
+	uint32_t version = SDL_ReadLE32(_file);
+	if (version > BinarySaveVersion)
+	{
+		SDL_RWclose(_file);
+		throw Exception(filename + " was saved by a newer version (binary save format " + std::to_string(version) + ")");
+	}
+	uint32_t count = SDL_ReadLE32(_file);
+	if (count > SAVE_SECTION_MAX)
+	{
+		SDL_RWclose(_file);
+		throw Exception(filename + " has a corrupted section table");
+	}
+	Sint64 position = SDL_RWtell(_file);
+	Sint64 fileSize = SDL_RWseek(_file, 0, RW_SEEK_END);
+	SDL_RWseek(_file, position, RW_SEEK_SET);
+	if (fileSize < HeaderSize + EntrySize * (Sint64)count)
+	{
+		SDL_RWclose(_file);
+		throw Exception(filename + " has a corrupted section table");
+	}
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		SaveSectionEntry entry;
+		entry.id = SDL_ReadLE32(_file);
+		entry.flags = SDL_ReadLE32(_file);
+		entry.offset = SDL_ReadLE64(_file);
+		entry.storedSize = SDL_ReadLE64(_file);
+		entry.rawSize = SDL_ReadLE64(_file);
+
+		// sizes come straight from the file, don't let a corrupted one make us allocate gigabytes
+		bool valid = entry.offset <= (uint64_t)fileSize && entry.storedSize <= (uint64_t)fileSize - entry.offset;
+		if (entry.flags & SectionCompressed)
+		{
+			valid = valid && entry.rawSize <= MaxRawSize && entry.rawSize <= entry.storedSize * MaxDeflateRatio;
+		}
+		if (!valid)
+		{
+			SDL_RWclose(_file);
+			throw Exception(filename + " has a corrupted section table");
+		}
+		_entries.push_back(entry);
+	}
+}
+
+/**
+ * Closes the file.
+ */
+BinarySaveReader::~BinarySaveReader()
+{
+	SDL_RWclose(_file);
+}
+
+/**
+ * Finds a section in the section table.
+ * @param id Section ID.
+ * @return Pointer to the entry, or null if the save doesn't have it.
+ */
+const SaveSectionEntry *BinarySaveReader::findEntry(SaveSection id) const
+{
+	for (const auto& entry : _entries)
+	{
+		if (entry.id == (uint32_t)id)
+		{
+			return &entry;
+		}
+	}
+	return nullptr;
+}
+
+/**
+ * Reads, decompresses and parses one section.
+ * @param id Section ID.
+ * @return Section contents, or an empty node if the save doesn't have it.
+ */
+YAML::Node BinarySaveReader::readSection(SaveSection id)
+{
+	const SaveSectionEntry *entry = findEntry(id);
+	if (!entry)
+	{
+		return YAML::Node();
+	}
+	std::vector<unsigned char> stored(entry->storedSize);
+	SDL_RWseek(_file, entry->offset, RW_SEEK_SET);
+	if (entry->storedSize > 0 && SDL_RWread(_file, stored.data(), stored.size(), 1) != 1)
+	{
+		throw Exception("Failed to read " + _filename + ": truncated section");
+	}
+	if (entry->flags & SectionCompressed)
+	{
+		std::string raw(entry->rawSize, '\0');
+		mz_ulong size = entry->rawSize;
+		if (mz_uncompress((unsigned char*)&raw[0], &size, stored.data(), stored.size()) != MZ_OK || size != entry->rawSize)
+		{
+			throw Exception("Failed to read " + _filename + ": corrupted section");
+		}
+		return YAML::Load(raw);
+	}
+	return YAML::Load(std::string(stored.begin(), stored.end()));
+}
+
+/**
+ * Reads all game sections and merges them into a single document,
+ * matching the second document of a YAML save.
+ * @return Full game data.
+ */
+YAML::Node BinarySaveReader::readGame()
+{
+	YAML::Node doc;
+	for (int i = SAVE_SECTION_GEOSCAPE; i < SAVE_SECTION_MAX; ++i)
+	{
+		YAML::Node section = readSection((SaveSection)i);
+		for (YAML::const_iterator it = section.begin(); it != section.end(); ++it)
+		{
+			doc[it->first.as<std::string>()] = it->second;
+		}
+	}
+	return doc;
+}
+
+}
@@ -0,0 +1,112 @@
+#pragma once
+/*
+ * Copyright 2010-2023 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <SDL_rwops.h>
+#include <yaml-cpp/yaml.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Sections of a saved game, in the order they are written.
+ * Never renumber these, they are stored in binary saves.
+ */
+enum SaveSection : int
+{
+	SAVE_SECTION_BRIEF,
+	SAVE_SECTION_GEOSCAPE,
+	SAVE_SECTION_BASES,
+	SAVE_SECTION_SOLDIERS,
+	SAVE_SECTION_BATTLE,
+	SAVE_SECTION_MAX
+};
+
+/**
+ * Entry of the section table of a binary save.
+ */
+struct SaveSectionEntry
+{
+	uint32_t id, flags;
+	uint64_t offset, storedSize, rawSize;
+};
+
+/**
+ * Writes a binary save container.
+ *
+ * Layout (all integers little endian):
+ * - magic "OXCS", u32 format version, u32 section count
+ * - section table, one entry per section: u32 id, u32 flags, u64 offset, u64 stored size, u64 raw size
+ * - section payloads
+ *
+ * Each payload is the YAML document of one section, deflated if compression is on.
+ * Sections are serialized, compressed and written one at a time,
+ * so the whole game never has to be held in memory as one YAML tree.
+ */
+class BinarySaveWriter
+{
+private:
+	std::string _filename;
+	SDL_RWops *_file;
+	int _compression;
+	std::vector<SaveSectionEntry> _entries;
+
+	void writeRaw(const void *data, size_t size);
+public:
+	/// Opens a binary save for writing.
+	BinarySaveWriter(const std::string &filename, int compression);
+	/// Closes the file.
+	~BinarySaveWriter();
+	/// Writes one section.
+	void writeSection(SaveSection id, const YAML::Node &node);
+	/// Writes the section table and closes the file.
+	void finish();
+};
+
+/**
+ * Reads a binary save container.
+ * Only the header and section table are read up front,
+ * sections are read and decoded on demand.
+ */
+class BinarySaveReader
+{
+private:
+	std::string _filename;
+	SDL_RWops *_file;
+	std::vector<SaveSectionEntry> _entries;
+
+	const SaveSectionEntry *findEntry(SaveSection id) const;
+public:
+	/// Checks if a file is a binary save.
+	static bool isBinarySave(const std::string &filename);
+	/// Opens a binary save and reads its section table.
+	BinarySaveReader(const std::string &filename);
+	/// Closes the file.
+	~BinarySaveReader();
+	/// Checks if the save has a section.
+	bool hasSection(SaveSection id) const { return findEntry(id) != nullptr; }
+	/// Reads and parses one section.
+	YAML::Node readSection(SaveSection id);
+	/// Reads all sections except the brief and merges them into one document.
+	YAML::Node readGame();
+};
+
+}
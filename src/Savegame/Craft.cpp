@@ -88,7 +88,7 @@ namespace OpenXcom
 Craft::Craft(const RuleCraft *rules, Base *base, int id) : MovingTarget(),
 	_rules(rules), _base(base), _fuel(0), _damage(0), _shield(0),
 	_interceptionOrder(0), _takeoff(0), _weapons(),
-	_status("STR_READY"), _lowFuel(false), _mission(false),
+	_status(CRAFT_READY), _lowFuel(false), _mission(false),
 	_inBattlescape(false), _inDogfight(false), _stats(),
 	_isAutoPatrolling(false), _lonAuto(0.0), _latAuto(0.0),
 	_skinIndex(0)
@@ -124,6 +124,10 @@ void Craft::recalcSpeedMaxRadian()
  */
 Craft::~Craft()
 {
+	if (_status == CRAFT_OUT)
+	{
+		invalidateActive();
+	}
 	for (auto* cw : _weapons)
 	{
 		delete cw;
@@ -213,7 +217,10 @@ void Craft::load(const YAML::Node &node, const ScriptGlobal *shared, const Mod *
 			Log(LOG_ERROR) << "Failed to load vehicles item " << type;
 		}
 	}
-	_status = node["status"].as<std::string>(_status);
+	if (const YAML::Node &status = node["status"])
+	{
+		setStatus(statusFromString(status.as<std::string>()));
+	}
 	_lowFuel = node["lowFuel"].as<bool>(_lowFuel);
 	_mission = node["mission"].as<bool>(_mission);
 	_interceptionOrder = node["interceptionOrder"].as<int>(_interceptionOrder);
@@ -375,7 +382,7 @@ YAML::Node Craft::save(const ScriptGlobal *shared) const
 	{
 		node["vehicles"].push_back(vehicle->save());
 	}
-	node["status"] = _status;
+	node["status"] = statusToString(_status);
 	if (_lowFuel)
 		node["lowFuel"] = _lowFuel;
 	if (_mission)
@@ -471,7 +478,7 @@ std::string Craft::getDefaultName(Language *lang) const
  */
 int Craft::getMarker() const
 {
-	if (_status != "STR_OUT")
+	if (_status != CRAFT_OUT)
 		return -1;
 	else if (_rules->getMarker() == -1)
 		return 1;
@@ -494,6 +501,10 @@ Base *Craft::getBase() const
  */
 void Craft::setBase(Base *base, bool move)
 {
+	if (_status == CRAFT_OUT)
+	{
+		invalidateActive();
+	}
 	_base = base;
 	if (move)
 	{
@@ -503,21 +514,82 @@ void Craft::setBase(Base *base, bool move)
 }
 
 /**
- * Returns the current status of the craft.
- * @return Status string.
+ * Changes the current status of the craft.
+ * @param status New status.
  */
-std::string Craft::getStatus() const
+void Craft::setStatus(CraftStatus status)
 {
-	return _status;
+	if (_status != status && (_status == CRAFT_OUT || status == CRAFT_OUT))
+	{
+		invalidateActive();
+	}
+	_status = status;
+}
+
+namespace
+{
+
+const std::string craftStatusNames[CRAFT_STATUS_MAX] =
+{
+	"STR_READY",
+	"STR_OUT",
+	"STR_REPAIRS",
+	"STR_REFUELLING",
+	"STR_REARMING",
+};
+
+unsigned int craftActiveRevision = 0;
+
 }
 
 /**
- * Changes the current status of the craft.
- * @param status Status string.
+ * Returns the string ID of a craft status,
+ * used for saving and for display.
+ * @param status Craft status.
+ * @return Status string ID.
  */
-void Craft::setStatus(const std::string &status)
+const std::string &Craft::statusToString(CraftStatus status)
 {
-	_status = status;
+	return craftStatusNames[status];
+}
+
+/**
+ * Returns the craft status matching a string ID.
+ * @param status Status string ID.
+ * @return Craft status, ready if unknown.
+ */
+CraftStatus Craft::statusFromString(const std::string &status)
+{
+	for (int i = 0; i < CRAFT_STATUS_MAX; ++i)
+	{
+		if (craftStatusNames[i] == status)
+		{
+			return (CraftStatus)i;
+		}
+	}
+	Log(LOG_WARNING) << "Unknown craft status " << status << ", assuming STR_READY";
+	return CRAFT_READY;
+}
+
+/**
+ * Bumps the revision of the set of active craft.
+ * Needs to be called when crafts or bases are reordered too,
+ * as the order of the active list drives the order of RNG calls.
+ */
+void Craft::invalidateActive()
+{
+	++craftActiveRevision;
+}
+
+/**
+ * Returns the revision of the set of active (out of base) craft.
+ * Anyone caching a filtered list of craft can compare this
+ * to skip rebuilding it when nothing relevant has changed.
+ * @return Revision number.
+ */
+unsigned int Craft::getActiveRevision()
+{
+	return craftActiveRevision;
 }
 
 /**
@@ -544,7 +616,7 @@ std::string Craft::getAltitude() const
  */
 void Craft::setDestination(Target *dest)
 {
-	if (_status != "STR_OUT")
+	if (_status != CRAFT_OUT)
 	{
 		_takeoff = 60;
 	}
@@ -865,11 +937,16 @@ int Craft::getDamage() const
  */
 void Craft::setDamage(int damage)
 {
+	bool destroyed = isDestroyed();
 	_damage = damage;
 	if (_damage < 0)
 	{
 		_damage = 0;
 	}
+	if (destroyed != isDestroyed() && _status == CRAFT_OUT)
+	{
+		invalidateActive();
+	}
 }
 
 /**
@@ -1139,19 +1216,19 @@ void Craft::checkup()
 
 	if (_damage > 0)
 	{
-		_status = "STR_REPAIRS";
+		setStatus(CRAFT_REPAIRS);
 	}
 	else if (available != full)
 	{
-		_status = "STR_REARMING";
+		setStatus(CRAFT_REARMING);
 	}
 	else if (_fuel < _stats.fuelMax)
 	{
-		_status = "STR_REFUELLING";
+		setStatus(CRAFT_REFUELLING);
 	}
 	else
 	{
-		_status = "STR_READY";
+		setStatus(CRAFT_READY);
 	}
 }
 
@@ -1271,7 +1348,7 @@ void Craft::repair()
 	setDamage(_damage - _rules->getRepairRate());
 	if (_damage <= 0)
 	{
-		_status = "STR_REARMING";
+		setStatus(CRAFT_REARMING);
 	}
 }
 
@@ -1303,7 +1380,7 @@ std::string Craft::refuel()
 				fuel = item;
 				if (_fuel > 0)
 				{
-					_status = "STR_READY";
+					setStatus(CRAFT_READY);
 				}
 				else
 				{
@@ -1314,12 +1391,12 @@ std::string Craft::refuel()
 	}
 	if (_fuel >= _stats.fuelMax)
 	{
-		_status = "STR_READY";
+		setStatus(CRAFT_READY);
 		for (const auto* cw : _weapons)
 		{
 			if (cw && cw->isRearming())
 			{
-				_status = "STR_REARMING";
+				setStatus(CRAFT_REARMING);
 				break;
 			}
 		}
@@ -1340,7 +1417,7 @@ const RuleItem* Craft::rearm()
 	{
 		if (iter == _weapons.end())
 		{
-			_status = "STR_REFUELLING";
+			setStatus(CRAFT_REFUELLING);
 			break;
 		}
 		CraftWeapon* cw = (*iter);
@@ -1818,7 +1895,7 @@ void Craft::reuseItem(const RuleItem* item)
 	// (And we don't want to interrupt any out-of-base status.)
 
 	// The only states we are willing to interrupt are "ready" and "refuelling"
-	if (_status != "STR_READY" && _status != "STR_REFUELLING")
+	if (_status != CRAFT_READY && _status != CRAFT_REFUELLING)
 	{
 		return;
 	}
@@ -1829,17 +1906,17 @@ void Craft::reuseItem(const RuleItem* item)
 		if (cw != 0 && item == cw->getRules()->getClipItem() && cw->getAmmo() < cw->getRules()->getAmmoMax() && !cw->isDisabled())
 		{
 			cw->setRearming(true);
-			_status = "STR_REARMING";
+			setStatus(CRAFT_REARMING);
 		}
 	}
 
 	// Only consider refuelling if everything else is complete
-	if (_status != "STR_READY")
+	if (_status != CRAFT_READY)
 		return;
 
 	// Check if it's fuel to refuel the craft
 	if (item->getType() == _rules->getRefuelItem() && _fuel < _stats.fuelMax)
-		_status = "STR_REFUELLING";
+		setStatus(CRAFT_REFUELLING);
 }
 
 /**
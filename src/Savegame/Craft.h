@@ -46,6 +46,20 @@ class ScriptGlobal;
 
 enum UfoDetection : int;
 
+/**
+ * Current state of a craft, in the base or on the geoscape.
+ * The order matches the vanilla CRAFT.DAT status field.
+ */
+enum CraftStatus : int
+{
+	CRAFT_READY,
+	CRAFT_OUT,
+	CRAFT_REPAIRS,
+	CRAFT_REFUELLING,
+	CRAFT_REARMING,
+	CRAFT_STATUS_MAX,
+};
+
 typedef std::pair<Position, int> SoldierDeploymentData;
 
 struct VehicleDeploymentData
@@ -80,7 +94,7 @@ private:
 	ItemContainer *_items;
 	ItemContainer *_tempSoldierItems;
 	std::vector<Vehicle*> _vehicles;
-	std::string _status;
+	CraftStatus _status;
 	bool _lowFuel, _mission, _inBattlescape, _inDogfight;
 	double _speedMaxRadian;
 	RuleCraftStats _stats;
@@ -127,9 +141,19 @@ public:
 	/// Sets the craft's base.
 	void setBase(Base *base, bool move = true);
 	/// Gets the craft's status.
-	std::string getStatus() const;
+	CraftStatus getStatus() const { return _status; }
 	/// Sets the craft's status.
-	void setStatus(const std::string &status);
+	void setStatus(CraftStatus status);
+	/// Gets the craft's status string ID.
+	const std::string &getStatusString() const { return statusToString(_status); }
+	/// Gets the string ID of a craft status.
+	static const std::string &statusToString(CraftStatus status);
+	/// Gets the craft status matching a string ID.
+	static CraftStatus statusFromString(const std::string &status);
+	/// Gets the revision of the set of active craft, changed whenever any craft is created, destroyed, reordered or changes status.
+	static unsigned int getActiveRevision();
+	/// Notifies listeners that the set or order of active craft may have changed.
+	static void invalidateActive();
 	/// Gets the craft's altitude.
 	std::string getAltitude() const;
 	/// Sets the craft's destination.
@@ -17,6 +17,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <assert.h>
+#include <algorithm>
 #include <vector>
 #include "BattleItem.h"
 #include "ItemContainer.h"
@@ -691,8 +692,14 @@ void SavedBattleGame::initMap(int mapsize_x, int mapsize_y, int mapsize_z, bool
 	_mapsize_y = mapsize_y;
 	_mapsize_z = mapsize_z;
 
+	// grid cells depend on map size
+	invalidateUnitGrid();
+
 	_tiles.clear();
+	_enviTiles.clear();
+	_dangerousTiles.clear();
 	_tiles.reserve(_mapsize_z * _mapsize_y * _mapsize_x);
+	_tileLight.assign(_mapsize_z * _mapsize_y * _mapsize_x, {});
 	for (int i = 0; i < _mapsize_z * _mapsize_y * _mapsize_x; ++i)
 	{
 		_tiles.push_back(Tile(getTileCoords(i), this));
@@ -1041,6 +1048,113 @@ std::vector<BattleUnit*> *SavedBattleGame::getUnits()
 	return &_units;
 }
 
+/**
+ * Gets the unit grid bucket for a position.
+ * @param pos Position on the map.
+ * @return Bucket of the area, or of units outside of the map.
+ */
+std::vector<int>& SavedBattleGame::getUnitGridCell(Position pos)
+{
+	if (pos.x < 0 || pos.y < 0 || pos.x >= _mapsize_x || pos.y >= _mapsize_y)
+	{
+		return _unitGridOutside;
+	}
+	const int width = (_mapsize_x + UnitGridCellSize - 1) / UnitGridCellSize;
+	return _unitGrid[(pos.y / UnitGridCellSize) * width + pos.x / UnitGridCellSize];
+}
+
+/**
+ * Fills the unit grid from scratch and tells every unit to keep its place in it updated.
+ */
+void SavedBattleGame::buildUnitGrid()
+{
+	const int width = (_mapsize_x + UnitGridCellSize - 1) / UnitGridCellSize;
+	const int height = (_mapsize_y + UnitGridCellSize - 1) / UnitGridCellSize;
+	_unitGrid.assign(width * height, {});
+	_unitGridOutside.clear();
+	for (int i = 0; i < (int)_units.size(); ++i)
+	{
+		_units[i]->setUnitGrid(this, i);
+		getUnitGridCell(_units[i]->getPosition()).push_back(i);
+	}
+	_unitGridSize = _units.size();
+	_unitGridValid = true;
+}
+
+/**
+ * Gets units that can be within a 2D distance of a position, in the same order as in getUnits().
+ * Units that are further away can be returned too, callers still need to check the distance.
+ * @param pos Center of the area.
+ * @param distance Max distance in tiles.
+ * @param units Found units.
+ */
+void SavedBattleGame::getUnitsNear(Position pos, int distance, std::vector<BattleUnit*> &units)
+{
+	if (!_unitGridValid || _unitGridSize != _units.size())
+	{
+		buildUnitGrid();
+	}
+
+	std::vector<int> found = _unitGridOutside;
+
+	const int width = (_mapsize_x + UnitGridCellSize - 1) / UnitGridCellSize;
+	const int height = (_mapsize_y + UnitGridCellSize - 1) / UnitGridCellSize;
+	const int minX = std::max(0, (pos.x - distance) / UnitGridCellSize);
+	const int minY = std::max(0, (pos.y - distance) / UnitGridCellSize);
+	const int maxX = std::min(width - 1, std::max(0, pos.x + distance) / UnitGridCellSize);
+	const int maxY = std::min(height - 1, std::max(0, pos.y + distance) / UnitGridCellSize);
+	for (int y = minY; y <= maxY; ++y)
+	{
+		for (int x = minX; x <= maxX; ++x)
+		{
+			const auto& cell = _unitGrid[y * width + x];
+			found.insert(found.end(), cell.begin(), cell.end());
+		}
+	}
+	std::sort(found.begin(), found.end());
+
+	units.clear();
+	for (int i : found)
+	{
+		units.push_back(_units[i]);
+	}
+}
+
+/**
+ * Moves a unit to its new place in the unit grid.
+ * @param index Index of the unit in getUnits().
+ * @param from Old position.
+ * @param to New position.
+ */
+void SavedBattleGame::moveUnitInGrid(int index, Position from, Position to)
+{
+	auto& oldCell = getUnitGridCell(from);
+	auto& newCell = getUnitGridCell(to);
+	if (&oldCell != &newCell)
+	{
+		auto it = std::find(oldCell.begin(), oldCell.end(), index);
+		if (it != oldCell.end())
+		{
+			oldCell.erase(it);
+		}
+		newCell.push_back(index);
+	}
+}
+
+/**
+ * Forces the unit grid to be rebuilt, needed when units are removed from the list.
+ */
+void SavedBattleGame::invalidateUnitGrid()
+{
+	for (auto* bu : _units)
+	{
+		bu->setUnitGrid(nullptr, -1);
+	}
+	_unitGrid.clear();
+	_unitGridOutside.clear();
+	_unitGridValid = false;
+}
+
 /**
  * Gets the list of items.
  * @return Pointer to the list of items.
@@ -2329,11 +2443,12 @@ void SavedBattleGame::prepareNewTurn()
 	std::vector<Tile*> tilesOnSmoke;
 
 	// prepare a list of tiles on fire
-	for (int i = 0; i < _mapsize_x * _mapsize_y * _mapsize_z; ++i)
+	updateEnviTiles();
+	for (auto* tile : _enviTiles)
 	{
-		if (getTile(i)->getFire() > 0)
+		if (tile->getFire() > 0)
 		{
-			tilesOnFire.push_back(getTile(i));
+			tilesOnFire.push_back(tile);
 		}
 	}
 
@@ -2398,14 +2513,19 @@ void SavedBattleGame::prepareNewTurn()
 	}
 
 	// prepare a list of tiles on fire/with smoke in them (smoke acts as fire intensity)
-	for (int i = 0; i < _mapsize_x * _mapsize_y * _mapsize_z; ++i)
+	updateEnviTiles();
+	for (auto* tile : _enviTiles)
 	{
-		if (getTile(i)->getSmoke() > 0)
+		if (tile->getSmoke() > 0)
 		{
-			tilesOnSmoke.push_back(getTile(i));
+			tilesOnSmoke.push_back(tile);
 		}
-		getTile(i)->setDangerous(false);
 	}
+	for (auto* tile : _dangerousTiles)
+	{
+		tile->setDangerous(false);
+	}
+	_dangerousTiles.clear();
 
 	// now make the smoke spread.
 	for (auto* tileOnSmoke : tilesOnSmoke)
@@ -2462,10 +2582,11 @@ void SavedBattleGame::prepareNewTurn()
 	if (!tilesOnFire.empty() || !tilesOnSmoke.empty())
 	{
 		// do damage to units, average out the smoke, etc.
-		for (int i = 0; i < _mapsize_x * _mapsize_y * _mapsize_z; ++i)
+		updateEnviTiles();
+		for (auto* tile : _enviTiles)
 		{
-			if (getTile(i)->getSmoke() != 0)
-				getTile(i)->prepareNewTurn(getDepth() == 0);
+			if (tile->getSmoke() != 0)
+				tile->prepareNewTurn(getDepth() == 0);
 		}
 	}
 
@@ -2478,6 +2599,27 @@ void SavedBattleGame::prepareNewTurn()
 	//fov and light udadates are done in `BattlescapeGame::endTurn`
 }
 
+/**
+ * Drops tiles that no longer have fire or smoke from the list of such tiles
+ * and sorts the remaining ones by their index, so they are processed in the same order as a full map scan would.
+ */
+void SavedBattleGame::updateEnviTiles()
+{
+	auto end = std::remove_if(_enviTiles.begin(), _enviTiles.end(),
+		[](Tile* tile)
+		{
+			if (tile->getFire() == 0 && tile->getSmoke() == 0)
+			{
+				tile->untrackEnvi();
+				return true;
+			}
+			return false;
+		}
+	);
+	_enviTiles.erase(end, _enviTiles.end());
+	std::sort(_enviTiles.begin(), _enviTiles.end());
+}
+
 /**
  * Checks for units that are unconscious and revives them if they shouldn't be.
  *
@@ -73,9 +73,22 @@ private:
 	int _mapsize_x, _mapsize_y, _mapsize_z;
 	std::vector<MapDataSet*> _mapDataSets;
 	std::vector<Tile> _tiles;
+	/// Light levels of tiles, kept outside of `Tile` so light updates sweep over small contiguous data.
+	std::vector<TileLight> _tileLight;
+	/// Tiles that got fire or smoke, can contain ones that already burned out.
+	std::vector<Tile*> _enviTiles;
+	/// Tiles with danger flag set.
+	std::vector<Tile*> _dangerousTiles;
 	BattleUnit *_selectedUnit, *_lastSelectedUnit;
 	std::vector<Node*> _nodes;
 	std::vector<BattleUnit*> _units;
+	/// Indexes of units in `_units` bucketed by map area, build on first use.
+	std::vector<std::vector<int>> _unitGrid;
+	/// Indexes of units outside of the map.
+	std::vector<int> _unitGridOutside;
+	/// Number of units in grid, grid is rebuilt when it changes.
+	size_t _unitGridSize = 0;
+	bool _unitGridValid = false;
 	std::vector<BattleItem*> _items, _deleted;
 	Pathfinding *_pathfinding;
 	TileEngine *_tileEngine;
@@ -127,6 +140,12 @@ private:
 	ScriptValues<SavedBattleGame> _scriptValues;
 	/// Selects a soldier.
 	BattleUnit *selectPlayerUnit(int dir, bool checkReselect = false, bool setReselect = false, bool checkInventory = false);
+	/// Gets the unit grid bucket for position.
+	std::vector<int>& getUnitGridCell(Position pos);
+	/// Fills the unit grid from scratch.
+	void buildUnitGrid();
+	/// Removes tiles without fire or smoke from the list and sorts it in map order.
+	void updateEnviTiles();
 	/// Run newTurnUnit and newTurnItem scripts
 	void newTurnUpdateScripts();
 public:
@@ -218,6 +237,14 @@ public:
 	std::vector<BattleItem*> *getItems();
 	/// Gets a pointer to the list of units.
 	std::vector<BattleUnit*> *getUnits();
+	/// Size of unit grid cells in tiles.
+	static constexpr int UnitGridCellSize = 8;
+	/// Gets units that can be within distance of a position.
+	void getUnitsNear(Position pos, int distance, std::vector<BattleUnit*> &units);
+	/// Moves a unit to its new place in the unit grid.
+	void moveUnitInGrid(int index, Position from, Position to);
+	/// Forces the unit grid to be rebuilt, needed when units are removed.
+	void invalidateUnitGrid();
 	/// Gets terrain size x.
 	int getMapSizeX() const { return _mapsize_x; }
 	/// Gets terrain size y.
@@ -298,6 +325,30 @@ public:
 		return &_tiles[i];
 	}
 
+	/// Gets the index of a tile from this map.
+	int getTileIndex(const Tile* tile) const
+	{
+		return static_cast<int>(tile - _tiles.data());
+	}
+
+	/// Gets light levels of tile at index.
+	TileLight& getTileLight(int i)
+	{
+		return _tileLight[i];
+	}
+
+	/// Gets light levels of a tile from this map.
+	TileLight& getTileLight(const Tile* tile)
+	{
+		return _tileLight[getTileIndex(tile)];
+	}
+
+	/// Gets light levels of a tile from this map.
+	const TileLight& getTileLight(const Tile* tile) const
+	{
+		return _tileLight[getTileIndex(tile)];
+	}
+
 	/**
 	 * Get tile that is below current one (const version).
 	 * @param tile
@@ -459,6 +510,10 @@ public:
 	Node *getSpawnNode(int nodeRank, BattleUnit *unit);
 	/// Gets a patrol node.
 	Node *getPatrolNode(bool scout, BattleUnit *unit, Node *fromNode);
+	/// Adds tile that got fire or smoke.
+	void addEnviTile(Tile *tile) { _enviTiles.push_back(tile); }
+	/// Adds tile that was flagged as dangerous.
+	void addDangerousTile(Tile *tile) { _dangerousTiles.push_back(tile); }
 	/// Carries out new turn preparations.
 	void prepareNewTurn();
 	/// Revives unconscious units (health check).
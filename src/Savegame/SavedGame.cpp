@@ -22,6 +22,8 @@
 #include <iomanip>
 #include <algorithm>
 #include <ctime>
+#include <cstring>
+#include <iterator>
 #include <yaml-cpp/yaml.h>
 #include "../version.h"
 #include "../Engine/Logger.h"
@@ -66,13 +68,17 @@
 #include "SoldierDiary.h"
 #include "../Mod/AlienRace.h"
 #include "RankCount.h"
+#include "BinarySave.h"
+#include "AsyncSave.h"
 
 namespace OpenXcom
 {
 
 const std::string SavedGame::AUTOSAVE_GEOSCAPE = "_autogeo_.asav",
 				  SavedGame::AUTOSAVE_BATTLESCAPE = "_autobattle_.asav",
-				  SavedGame::QUICKSAVE = "_quick_.asav";
+				  SavedGame::QUICKSAVE = "_quick_.asav",
+				  SavedGame::SAVE_INDEX = "saveindex.cache";
+const int SavedGame::SAVE_INDEX_VERSION = 2;
 
 namespace
 {
@@ -138,6 +144,138 @@ bool haveReserchVector(const std::vector<const RuleResearch*> &vec,  const std::
 	return find != vec.end();
 }
 
+const char SaveIndexMagic[4] = { 'O', 'X', 'S', 'I' };
+
+void writeIndexInt(std::string &out, uint64_t v, int bytes)
+{
+	for (int i = 0; i < bytes; ++i)
+	{
+		out.push_back((char)((v >> (8 * i)) & 0xFF));
+	}
+}
+
+void writeIndexString(std::string &out, const std::string &str)
+{
+	writeIndexInt(out, str.size(), 4);
+	out.append(str);
+}
+
+/**
+ * Reads the fields of the save index from memory.
+ * Stops reading once it runs out of data.
+ */
+struct SaveIndexReader
+{
+	const char *pos, *end;
+	bool ok;
+
+	SaveIndexReader(const std::string &data) : pos(data.data()), end(data.data() + data.size()), ok(true)
+	{
+	}
+
+	uint64_t readInt(int bytes)
+	{
+		uint64_t v = 0;
+		if (!ok || end - pos < bytes)
+		{
+			ok = false;
+			return v;
+		}
+		for (int i = 0; i < bytes; ++i)
+		{
+			v |= (uint64_t)(unsigned char)pos[i] << (8 * i);
+		}
+		pos += bytes;
+		return v;
+	}
+
+	std::string readString()
+	{
+		uint64_t size = readInt(4);
+		if (!ok || (uint64_t)(end - pos) < size)
+		{
+			ok = false;
+			return std::string();
+		}
+		std::string str(pos, size);
+		pos += size;
+		return str;
+	}
+};
+
+/// Geoscape keys that come before the bases in the full game document.
+const char *const KeysBeforeBases[] =
+{
+	"difficulty", "end", "monthsPassed", "graphRegionToggles", "graphCountryToggles", "graphFinanceToggles",
+	"rng", "funds", "maintenance", "userNotes", "researchScores", "incomes", "expenditures", "warned",
+	"togglePersonalLight", "toggleNightVision", "toggleBrightness", "globeLon", "globeLat", "globeZoom",
+	"ids", "countries", "regions",
+};
+
+/**
+ * Writes one key of a save section, if the section has it.
+ */
+void emitSectionKey(YAML::Emitter &out, const YAML::Node &section, const char *key)
+{
+	if (section[key])
+	{
+		out << YAML::Key << key << YAML::Value << section[key];
+	}
+}
+
+/**
+ * Writes the save sections as the full game document, with the keys
+ * in the same order as saves written before the game was split into sections.
+ * @param out YAML emitter.
+ * @param sections Save sections, indexed by SaveSection.
+ */
+void emitFullGame(YAML::Emitter &out, const std::vector<YAML::Node> &sections)
+{
+	const YAML::Node &bases = sections[SAVE_SECTION_BASES];
+	const YAML::Node &soldiers = sections[SAVE_SECTION_SOLDIERS];
+	const YAML::Node &battle = sections[SAVE_SECTION_BATTLE];
+	bool basesDone = false, statisticsDone = false, battleDone = false;
+
+	out << YAML::BeginMap;
+	for (YAML::const_iterator it = sections[SAVE_SECTION_GEOSCAPE].begin(); it != sections[SAVE_SECTION_GEOSCAPE].end(); ++it)
+	{
+		const std::string key = it->first.as<std::string>();
+		if (!basesDone && std::find(std::begin(KeysBeforeBases), std::end(KeysBeforeBases), key) == std::end(KeysBeforeBases))
+		{
+			emitSectionKey(out, bases, "bases");
+			basesDone = true;
+		}
+		if (!statisticsDone && (key == "autoSales" || key == "options"))
+		{
+			emitSectionKey(out, soldiers, "missionStatistics");
+			statisticsDone = true;
+		}
+		out << YAML::Key << it->first << YAML::Value << it->second;
+		if (key == "alienStrategy")
+		{
+			emitSectionKey(out, soldiers, "deadSoldiers");
+		}
+		else if (key == "options")
+		{
+			emitSectionKey(out, battle, "battleGame");
+			battleDone = true;
+		}
+	}
+	if (!basesDone)
+	{
+		emitSectionKey(out, bases, "bases");
+	}
+	if (!statisticsDone)
+	{
+		emitSectionKey(out, soldiers, "missionStatistics");
+	}
+	if (!battleDone)
+	{
+		emitSectionKey(out, battle, "battleGame");
+	}
+	out << YAML::EndMap;
+}
+
 }
 
 /**
@@ -281,12 +419,15 @@ static bool _isCurrentGameType(const SaveInfo &saveInfo, const std::string &curM
 
 /**
  * Gets all the info of the saves found in the user folder.
+ * The brief headers are cached in an index next to the saves,
+ * so only new or modified saves have to be opened.
  * @param lang Loaded language.
  * @param autoquick Include autosaves and quicksaves.
  * @return List of saves info.
  */
 std::vector<SaveInfo> SavedGame::getList(Language *lang, bool autoquick)
 {
+	AsyncSave::flush();
 	std::vector<SaveInfo> info;
 	std::string curMaster = Options::getActiveMaster();
 	auto saves = CrossPlatform::getFolderContents(Options::getMasterUserFolder(), "sav");
@@ -296,12 +437,32 @@ std::vector<SaveInfo> SavedGame::getList(Language *lang, bool autoquick)
 		auto asaves = CrossPlatform::getFolderContents(Options::getMasterUserFolder(), "asav");
 		saves.insert(saves.begin(), asaves.begin(), asaves.end());
 	}
+
+	std::string indexPath = Options::getMasterUserFolder() + SAVE_INDEX;
+	std::map<std::string, SaveIndexEntry> index = loadSaveIndex(indexPath);
+	bool indexChanged = false;
+	std::set<std::string> found;
+
 	for (const auto& tuple : saves)
 	{
 		const auto& filename = std::get<0>(tuple);
+		time_t timestamp = std::get<2>(tuple);
+		found.insert(filename);
 		try
 		{
-			SaveInfo saveInfo = getSaveInfo(filename, lang);
+			std::string fullname = Options::getMasterUserFolder() + filename;
+			int64_t size = CrossPlatform::getFileSize(fullname);
+			SaveIndexEntry &entry = index[filename];
+			if (entry.size < 0 || entry.timestamp != timestamp || entry.size != size)
+			{
+				// stays invalid if the save can't be read
+				entry.size = -1;
+				indexChanged = true;
+				entry.brief = getSaveBrief(fullname);
+				entry.timestamp = timestamp;
+				entry.size = size;
+			}
+			SaveInfo saveInfo = getSaveInfo(filename, entry.brief, timestamp, lang);
 			if (!_isCurrentGameType(saveInfo, curMaster))
 			{
 				continue;
@@ -320,18 +481,217 @@ std::vector<SaveInfo> SavedGame::getList(Language *lang, bool autoquick)
 		}
 	}
 
+	// forget saves that were deleted
+	for (auto i = index.begin(); i != index.end();)
+	{
+		bool listed = autoquick || CrossPlatform::compareExt(i->first, "sav");
+		if (i->second.size < 0 || (listed && found.find(i->first) == found.end()))
+		{
+			i = index.erase(i);
+			indexChanged = true;
+		}
+		else
+		{
+			++i;
+		}
+	}
+	if (indexChanged)
+	{
+		saveSaveIndex(indexPath, index);
+	}
+
 	return info;
 }
 
+/**
+ * Loads the cached brief headers of the saves.
+ * A missing or broken index is simply rebuilt.
+ * @param path Full path of the index.
+ * @return Index entries by save filename.
+ */
+std::map<std::string, SavedGame::SaveIndexEntry> SavedGame::loadSaveIndex(const std::string &path)
+{
+	std::map<std::string, SaveIndexEntry> index;
+	if (!CrossPlatform::fileExists(path))
+	{
+		return index;
+	}
+	std::unique_ptr<std::istream> file = CrossPlatform::readFile(path);
+	std::string data((std::istreambuf_iterator<char>(*file)), std::istreambuf_iterator<char>());
+	if (data.size() < sizeof(SaveIndexMagic) || memcmp(data.data(), SaveIndexMagic, sizeof(SaveIndexMagic)) != 0)
+	{
+		return index;
+	}
+	SaveIndexReader reader(data);
+	reader.pos += sizeof(SaveIndexMagic);
+	if (reader.readInt(4) != (uint64_t)SAVE_INDEX_VERSION)
+	{
+		return index;
+	}
+	uint64_t count = reader.readInt(4);
+	for (uint64_t i = 0; reader.ok && i < count; ++i)
+	{
+		std::string filename = reader.readString();
+		SaveIndexEntry entry;
+		entry.timestamp = (time_t)reader.readInt(8);
+		entry.size = (int64_t)reader.readInt(8);
+		entry.brief.name = reader.readString();
+		entry.brief.mission = reader.readString();
+		entry.brief.battle = reader.readInt(1) != 0;
+		entry.brief.turn = (int)reader.readInt(4);
+		entry.brief.day = (int)reader.readInt(4);
+		entry.brief.month = (int)reader.readInt(4);
+		entry.brief.year = (int)reader.readInt(4);
+		entry.brief.hour = (int)reader.readInt(4);
+		entry.brief.minute = (int)reader.readInt(4);
+		entry.brief.ironman = reader.readInt(1) != 0;
+		uint64_t mods = reader.readInt(4);
+		for (uint64_t j = 0; reader.ok && j < mods; ++j)
+		{
+			entry.brief.mods.push_back(reader.readString());
+		}
+		if (reader.ok)
+		{
+			index[filename] = entry;
+		}
+	}
+	if (!reader.ok)
+	{
+		Log(LOG_WARNING) << "Ignoring corrupted save index " << path;
+		index.clear();
+	}
+	return index;
+}
+
+/**
+ * Writes the cached brief headers of the saves.
+ * @param path Full path of the index.
+ * @param index Index entries by save filename.
+ */
+void SavedGame::saveSaveIndex(const std::string &path, const std::map<std::string, SaveIndexEntry> &index)
+{
+	std::string out;
+	out.append(SaveIndexMagic, sizeof(SaveIndexMagic));
+	writeIndexInt(out, SAVE_INDEX_VERSION, 4);
+	writeIndexInt(out, index.size(), 4);
+	for (const auto& pair : index)
+	{
+		const SaveBrief &brief = pair.second.brief;
+		writeIndexString(out, pair.first);
+		writeIndexInt(out, (uint64_t)pair.second.timestamp, 8);
+		writeIndexInt(out, (uint64_t)pair.second.size, 8);
+		writeIndexString(out, brief.name);
+		writeIndexString(out, brief.mission);
+		writeIndexInt(out, brief.battle, 1);
+		writeIndexInt(out, (uint32_t)brief.turn, 4);
+		writeIndexInt(out, (uint32_t)brief.day, 4);
+		writeIndexInt(out, (uint32_t)brief.month, 4);
+		writeIndexInt(out, (uint32_t)brief.year, 4);
+		writeIndexInt(out, (uint32_t)brief.hour, 4);
+		writeIndexInt(out, (uint32_t)brief.minute, 4);
+		writeIndexInt(out, brief.ironman, 1);
+		writeIndexInt(out, brief.mods.size(), 4);
+		for (const auto& mod : brief.mods)
+		{
+			writeIndexString(out, mod);
+		}
+	}
+	CrossPlatform::writeFile(path, out);
+}
+
+/**
+ * Updates the index entry of a save that was just written,
+ * so the save list doesn't have to open it again.
+ * @param filename Save filename, relative to the user folder.
+ * @param brief Decoded brief header of the save.
+ */
+void SavedGame::updateSaveIndex(const std::string &filename, const SaveBrief &brief)
+{
+	std::string indexPath = Options::getMasterUserFolder() + SAVE_INDEX;
+	std::string fullname = Options::getMasterUserFolder() + filename;
+	std::map<std::string, SaveIndexEntry> index = loadSaveIndex(indexPath);
+	SaveIndexEntry &entry = index[filename];
+	entry.timestamp = CrossPlatform::getDateModified(fullname);
+	entry.size = CrossPlatform::getFileSize(fullname);
+	entry.brief = brief;
+	saveSaveIndex(indexPath, index);
+}
+
+/**
+ * Updates the index entry of this game's save.
+ * @param filename Save filename, relative to the user folder.
+ */
+void SavedGame::updateSaveIndex(const std::string &filename) const
+{
+	updateSaveIndex(filename, decodeSaveBrief(saveBrief()));
+}
+
+/**
+ * Removes a save from the index.
+ * @param filename Save filename, relative to the user folder.
+ */
+void SavedGame::removeFromSaveIndex(const std::string &filename)
+{
+	std::string indexPath = Options::getMasterUserFolder() + SAVE_INDEX;
+	std::map<std::string, SaveIndexEntry> index = loadSaveIndex(indexPath);
+	if (index.erase(filename) > 0)
+	{
+		saveSaveIndex(indexPath, index);
+	}
+}
+
+/**
+ * Reads the brief header of a specific save file.
+ * @param fullname Full path of the save.
+ * @return Brief save info.
+ */
+SaveBrief SavedGame::getSaveBrief(const std::string &fullname)
+{
+	if (BinarySaveReader::isBinarySave(fullname))
+	{
+		// only the brief section is read from binary saves
+		BinarySaveReader reader(fullname);
+		return decodeSaveBrief(reader.readSection(SAVE_SECTION_BRIEF));
+	}
+	return decodeSaveBrief(YAML::Load(*CrossPlatform::getYamlSaveHeader(fullname)));
+}
+
+/**
+ * Decodes the brief header of a save into the info shown in the save list.
+ * @param doc Brief save info.
+ * @return Decoded brief.
+ */
+SaveBrief SavedGame::decodeSaveBrief(const YAML::Node &doc)
+{
+	SaveBrief brief;
+	brief.name = doc["name"].as<std::string>(brief.name);
+	if (doc["turn"])
+	{
+		brief.battle = true;
+		brief.turn = doc["turn"].as<int>(brief.turn);
+		brief.mission = doc["mission"].as<std::string>(brief.mission);
+	}
+	GameTime time = GameTime(6, 1, 1, 1999, 12, 0, 0);
+	time.load(doc["time"]);
+	brief.day = time.getDay();
+	brief.month = time.getMonth();
+	brief.year = time.getYear();
+	brief.hour = time.getHour();
+	brief.minute = time.getMinute();
+	brief.ironman = doc["ironman"].as<bool>(brief.ironman);
+	brief.mods = doc["mods"].as<std::vector< std::string> >(std::vector<std::string>());
+	return brief;
+}
+
 /**
  * Gets the info of a specific save file.
  * @param file Save filename.
+ * @param brief Decoded brief save info.
+ * @param timestamp Last modified date of the save.
  * @param lang Loaded language.
  */
-SaveInfo SavedGame::getSaveInfo(const std::string &file, Language *lang)
+SaveInfo SavedGame::getSaveInfo(const std::string &file, const SaveBrief &brief, time_t timestamp, Language *lang)
 {
-	std::string fullname = Options::getMasterUserFolder() + file;
-	YAML::Node doc = YAML::Load(*CrossPlatform::getYamlSaveHeader(fullname));
 	SaveInfo save;
 
 	save.fileName = file;
@@ -353,19 +713,14 @@ SaveInfo SavedGame::getSaveInfo(const std::string &file, Language *lang)
 	}
 	else if (save.fileName.find(AUTOSAVE_BATTLESCAPE) != std::string::npos)
 	{
-		int turn = 0;
-		if (doc["turn"])
-		{
-			turn = doc["turn"].as<int>(turn);
-		}
-		save.displayName = lang->getString("STR_AUTO_SAVE_BATTLESCAPE_SLOT_WITH_NUMBER").arg(turn);
+		save.displayName = lang->getString("STR_AUTO_SAVE_BATTLESCAPE_SLOT_WITH_NUMBER").arg(brief.turn);
 		save.reserved = true;
 	}
 	else
 	{
-		if (doc["name"])
+		if (!brief.name.empty())
 		{
-			save.displayName = doc["name"].as<std::string>();
+			save.displayName = brief.name;
 		}
 		else
 		{
@@ -374,27 +729,26 @@ SaveInfo SavedGame::getSaveInfo(const std::string &file, Language *lang)
 		save.reserved = false;
 	}
 
-	save.timestamp = CrossPlatform::getDateModified(fullname);
+	save.timestamp = timestamp;
 	std::pair<std::string, std::string> str = CrossPlatform::timeToString(save.timestamp);
 	save.isoDate = str.first;
 	save.isoTime = str.second;
-	save.mods = doc["mods"].as<std::vector< std::string> >(std::vector<std::string>());
+	save.mods = brief.mods;
 
 	std::ostringstream details;
-	if (doc["turn"])
+	if (brief.battle)
 	{
-		details << lang->getString("STR_BATTLESCAPE") << ": " << lang->getString(doc["mission"].as<std::string>()) << ", ";
-		details << lang->getString("STR_TURN").arg(doc["turn"].as<int>());
+		details << lang->getString("STR_BATTLESCAPE") << ": " << lang->getString(brief.mission) << ", ";
+		details << lang->getString("STR_TURN").arg(brief.turn);
 	}
 	else
 	{
-		GameTime time = GameTime(6, 1, 1, 1999, 12, 0, 0);
-		time.load(doc["time"]);
+		GameTime time = GameTime(6, brief.day, brief.month, brief.year, brief.hour, brief.minute, 0);
 		details << lang->getString("STR_GEOSCAPE") << ": ";
 		details << time.getDayString(lang) << " " << lang->getString(time.getMonthString()) << " " << time.getYear() << ", ";
 		details << time.getHour() << ":" << std::setfill('0') << std::setw(2) << time.getMinute();
 	}
-	if (doc["ironman"].as<bool>(false))
+	if (brief.ironman)
 	{
 		details << " (" << lang->getString("STR_IRONMAN") << ")";
 	}
@@ -404,7 +758,7 @@ SaveInfo SavedGame::getSaveInfo(const std::string &file, Language *lang)
 }
 
 /**
- * Loads a saved game's contents from a YAML file.
+ * Loads a saved game's contents from a YAML file or a binary save.
  * @note Assumes the saved game is blank.
  * @param filename YAML filename.
  * @param mod Mod for the saved game.
@@ -412,10 +766,22 @@ SaveInfo SavedGame::getSaveInfo(const std::string &file, Language *lang)
  */
 void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 {
+	AsyncSave::flush();
 	std::string filepath = Options::getMasterUserFolder() + filename;
-	std::vector<YAML::Node> file = YAML::LoadAll(*CrossPlatform::readFile(filepath));
+	YAML::Node brief, doc;
+	if (BinarySaveReader::isBinarySave(filepath))
+	{
+		BinarySaveReader reader(filepath);
+		brief = reader.readSection(SAVE_SECTION_BRIEF);
+		doc = reader.readGame();
+	}
+	else
+	{
+		std::vector<YAML::Node> file = YAML::LoadAll(*CrossPlatform::readFile(filepath));
+		brief = file[0];
+		doc = file[1];
+	}
 	// Get brief save info
-	YAML::Node brief = file[0];
 	_time->load(brief["time"]);
 	if (brief["name"])
 	{
@@ -428,7 +794,6 @@ void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 	_ironman = brief["ironman"].as<bool>(_ironman);
 
 	// Get full save data
-	YAML::Node doc = file[1];
 	_difficulty = (GameDifficulty)doc["difficulty"].as<int>(_difficulty);
 	_end = (GameEnding)doc["end"].as<int>(_end);
 	if (doc["rng"] && (_ironman || !Options::newSeedOnLoad))
@@ -799,14 +1164,11 @@ void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 }
 
 /**
- * Saves a saved game's contents to a YAML file.
- * @param filename YAML filename.
+ * Saves the brief game info used in the saves list.
+ * @return YAML node.
  */
-void SavedGame::save(const std::string &filename, Mod *mod) const
+YAML::Node SavedGame::saveBrief() const
 {
-	YAML::Emitter out;
-
-	// Saves the brief game info used in the saves list
 	YAML::Node brief;
 	brief["name"] = _name;
 	brief["version"] = OPENXCOM_VERSION_SHORT;
@@ -835,163 +1197,293 @@ void SavedGame::save(const std::string &filename, Mod *mod) const
 	brief["mods"] = modsList;
 	if (_ironman)
 		brief["ironman"] = _ironman;
-	out << brief;
-	// Saves the full game data to the save
-	out << YAML::BeginDoc;
-	YAML::Node node;
-	node["difficulty"] = (int)_difficulty;
-	node["end"] = (int)_end;
-	node["monthsPassed"] = _monthsPassed;
-	node["graphRegionToggles"] = _graphRegionToggles;
-	node["graphCountryToggles"] = _graphCountryToggles;
-	node["graphFinanceToggles"] = _graphFinanceToggles;
-	node["rng"] = RNG::getSeed();
-	node["funds"] = _funds;
-	node["maintenance"] = _maintenance;
-	node["userNotes"] = _userNotes;
-	node["researchScores"] = _researchScores;
-	node["incomes"] = _incomes;
-	node["expenditures"] = _expenditures;
-	node["warned"] = _warned;
-	node["togglePersonalLight"] = _togglePersonalLight;
-	node["toggleNightVision"] = _toggleNightVision;
-	node["toggleBrightness"] = _toggleBrightness;
-	node["globeLon"] = serializeDouble(_globeLon);
-	node["globeLat"] = serializeDouble(_globeLat);
-	node["globeZoom"] = _globeZoom;
-	node["ids"] = _ids;
-	for (const auto* country : _countries)
-	{
-		node["countries"].push_back(country->save());
-	}
-	for (const auto* region : _regions)
-	{
-		node["regions"].push_back(region->save());
-	}
-	for (const auto* xbase : _bases)
-	{
-		node["bases"].push_back(xbase->save());
-	}
-	for (const auto* wp : _waypoints)
-	{
-		node["waypoints"].push_back(wp->save());
-	}
-	for (const auto* site : _missionSites)
-	{
-		node["missionSites"].push_back(site->save());
-	}
-	// Alien bases must be saved before alien missions.
-	for (const auto* ab : _alienBases)
-	{
-		node["alienBases"].push_back(ab->save());
-	}
-	// Missions must be saved before UFOs, but after alien bases.
-	for (const auto* am : _activeMissions)
-	{
-		node["alienMissions"].push_back(am->save());
-	}
-	// UFOs must be after missions
-	for (const auto* ufo : _ufos)
-	{
-		node["ufos"].push_back(ufo->save(mod->getScriptGlobal(), getMonthsPassed() == -1));
-	}
-	for (const auto* ge : _geoscapeEvents)
-	{
-		node["geoscapeEvents"].push_back(ge->save());
-	}
-	for (const auto* research : _discovered)
-	{
-		node["discovered"].push_back(research->getName());
-	}
-	for (const auto* research : _poppedResearch)
-	{
-		node["poppedResearch"].push_back(research->getName());
-	}
-	node["generatedEvents"] = _generatedEvents;
-	node["ufopediaRuleStatus"] = _ufopediaRuleStatus;
-	node["manufactureRuleStatus"] = _manufactureRuleStatus;
-	node["researchRuleStatus"] = _researchRuleStatus;
-	node["monthlyPurchaseLimitLog"] = _monthlyPurchaseLimitLog;
-	node["hiddenPurchaseItems"] = _hiddenPurchaseItemsMap;
-	node["customRuleCraftDeployments"] = _customRuleCraftDeployments;
-	node["alienStrategy"] = _alienStrategy->save();
-	for (const auto* soldier : _deadSoldiers)
-	{
-		node["deadSoldiers"].push_back(soldier->save(mod->getScriptGlobal()));
-	}
-	for (int j = 0; j < Options::oxceMaxEquipmentLayoutTemplates; ++j)
-	{
-		std::ostringstream oss;
-		oss << "globalEquipmentLayout" << j;
-		std::string key = oss.str();
-		if (!_globalEquipmentLayout[j].empty())
+	return brief;
+}
+
+/**
+ * Saves one section of the full game data.
+ * The sections merged together make up the full game document.
+ * @param section Section to save.
+ * @param node YAML node to fill.
+ * @param mod Mod for the saved game.
+ */
+void SavedGame::saveSection(SaveSection section, YAML::Node &node, Mod *mod) const
+{
+	switch (section)
+	{
+	case SAVE_SECTION_GEOSCAPE:
+	{
+		node["difficulty"] = (int)_difficulty;
+		node["end"] = (int)_end;
+		node["monthsPassed"] = _monthsPassed;
+		node["graphRegionToggles"] = _graphRegionToggles;
+		node["graphCountryToggles"] = _graphCountryToggles;
+		node["graphFinanceToggles"] = _graphFinanceToggles;
+		node["rng"] = RNG::getSeed();
+		node["funds"] = _funds;
+		node["maintenance"] = _maintenance;
+		node["userNotes"] = _userNotes;
+		node["researchScores"] = _researchScores;
+		node["incomes"] = _incomes;
+		node["expenditures"] = _expenditures;
+		node["warned"] = _warned;
+		node["togglePersonalLight"] = _togglePersonalLight;
+		node["toggleNightVision"] = _toggleNightVision;
+		node["toggleBrightness"] = _toggleBrightness;
+		node["globeLon"] = serializeDouble(_globeLon);
+		node["globeLat"] = serializeDouble(_globeLat);
+		node["globeZoom"] = _globeZoom;
+		node["ids"] = _ids;
+		for (const auto* country : _countries)
 		{
-			for (const auto* entry : _globalEquipmentLayout[j])
-				node[key].push_back(entry->save());
+			node["countries"].push_back(country->save());
 		}
-		std::ostringstream oss2;
-		oss2 << "globalEquipmentLayoutName" << j;
-		std::string key2 = oss2.str();
-		if (!_globalEquipmentLayoutName[j].empty())
+		for (const auto* region : _regions)
 		{
-			node[key2] = _globalEquipmentLayoutName[j];
+			node["regions"].push_back(region->save());
 		}
-		std::ostringstream oss3;
-		oss3 << "globalEquipmentLayoutArmor" << j;
-		std::string key3 = oss3.str();
-		if (!_globalEquipmentLayoutArmor[j].empty())
+		for (const auto* wp : _waypoints)
 		{
-			node[key3] = _globalEquipmentLayoutArmor[j];
+			node["waypoints"].push_back(wp->save());
 		}
-	}
-	for (int j = 0; j < MAX_CRAFT_LOADOUT_TEMPLATES; ++j)
-	{
-		std::ostringstream oss;
-		oss << "globalCraftLoadout" << j;
-		std::string key = oss.str();
-		if (!_globalCraftLoadout[j]->getContents()->empty())
+		for (const auto* site : _missionSites)
 		{
-			node[key] = _globalCraftLoadout[j]->save();
+			node["missionSites"].push_back(site->save());
 		}
-		std::ostringstream oss2;
-		oss2 << "globalCraftLoadoutName" << j;
-		std::string key2 = oss2.str();
-		if (!_globalCraftLoadoutName[j].empty())
+		// Alien bases must be saved before alien missions.
+		for (const auto* ab : _alienBases)
+		{
+			node["alienBases"].push_back(ab->save());
+		}
+		// Missions must be saved before UFOs, but after alien bases.
+		for (const auto* am : _activeMissions)
+		{
+			node["alienMissions"].push_back(am->save());
+		}
+		// UFOs must be after missions
+		for (const auto* ufo : _ufos)
+		{
+			node["ufos"].push_back(ufo->save(mod->getScriptGlobal(), getMonthsPassed() == -1));
+		}
+		for (const auto* ge : _geoscapeEvents)
+		{
+			node["geoscapeEvents"].push_back(ge->save());
+		}
+		for (const auto* research : _discovered)
+		{
+			node["discovered"].push_back(research->getName());
+		}
+		for (const auto* research : _poppedResearch)
+		{
+			node["poppedResearch"].push_back(research->getName());
+		}
+		node["generatedEvents"] = _generatedEvents;
+		node["ufopediaRuleStatus"] = _ufopediaRuleStatus;
+		node["manufactureRuleStatus"] = _manufactureRuleStatus;
+		node["researchRuleStatus"] = _researchRuleStatus;
+		node["monthlyPurchaseLimitLog"] = _monthlyPurchaseLimitLog;
+		node["hiddenPurchaseItems"] = _hiddenPurchaseItemsMap;
+		node["customRuleCraftDeployments"] = _customRuleCraftDeployments;
+		node["alienStrategy"] = _alienStrategy->save();
+		for (int j = 0; j < Options::oxceMaxEquipmentLayoutTemplates; ++j)
+		{
+			std::ostringstream oss;
+			oss << "globalEquipmentLayout" << j;
+			std::string key = oss.str();
+			if (!_globalEquipmentLayout[j].empty())
+			{
+				for (const auto* entry : _globalEquipmentLayout[j])
+					node[key].push_back(entry->save());
+			}
+			std::ostringstream oss2;
+			oss2 << "globalEquipmentLayoutName" << j;
+			std::string key2 = oss2.str();
+			if (!_globalEquipmentLayoutName[j].empty())
+			{
+				node[key2] = _globalEquipmentLayoutName[j];
+			}
+			std::ostringstream oss3;
+			oss3 << "globalEquipmentLayoutArmor" << j;
+			std::string key3 = oss3.str();
+			if (!_globalEquipmentLayoutArmor[j].empty())
+			{
+				node[key3] = _globalEquipmentLayoutArmor[j];
+			}
+		}
+		for (int j = 0; j < MAX_CRAFT_LOADOUT_TEMPLATES; ++j)
+		{
+			std::ostringstream oss;
+			oss << "globalCraftLoadout" << j;
+			std::string key = oss.str();
+			if (!_globalCraftLoadout[j]->getContents()->empty())
+			{
+				node[key] = _globalCraftLoadout[j]->save();
+			}
+			std::ostringstream oss2;
+			oss2 << "globalCraftLoadoutName" << j;
+			std::string key2 = oss2.str();
+			if (!_globalCraftLoadoutName[j].empty())
+			{
+				node[key2] = _globalCraftLoadoutName[j];
+			}
+		}
+		for (const auto* ruleItem : _autosales)
+		{
+			node["autoSales"].push_back(ruleItem->getName());
+		}
+		// snapshot of the user options (just for debugging purposes)
 		{
-			node[key2] = _globalCraftLoadoutName[j];
+			YAML::Node tmpNode;
+			for (const auto& info : Options::getOptionInfo())
+			{
+				info.save(tmpNode);
+			}
+			node["options"] = tmpNode;
 		}
+		_scriptValues.save(node, mod->getScriptGlobal());
+		break;
 	}
-	if (Options::soldierDiaries)
-	{
-		for (const auto* ms : _missionStatistics)
+	case SAVE_SECTION_BASES:
+		for (const auto* xbase : _bases)
+		{
+			node["bases"].push_back(xbase->save());
+		}
+		break;
+	case SAVE_SECTION_SOLDIERS:
+		for (const auto* soldier : _deadSoldiers)
+		{
+			node["deadSoldiers"].push_back(soldier->save(mod->getScriptGlobal()));
+		}
+		if (Options::soldierDiaries)
+		{
+			for (const auto* ms : _missionStatistics)
+			{
+				node["missionStatistics"].push_back(ms->save());
+			}
+		}
+		break;
+	case SAVE_SECTION_BATTLE:
+		if (_battleGame != 0)
 		{
-			node["missionStatistics"].push_back(ms->save());
+			node["battleGame"] = _battleGame->save();
 		}
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * Saves a saved game's contents to a file,
+ * either as YAML or as a binary save depending on the user options.
+ * @param filename YAML filename.
+ * @param mod Mod for the saved game.
+ */
+void SavedGame::save(const std::string &filename, Mod *mod) const
+{
+	AsyncSave::flush();
+	std::string filepath = Options::getMasterUserFolder() + filename;
+	if (Options::oxceBinarySaves)
+	{
+		saveBinary(filepath, mod);
 	}
-	for (const auto* ruleItem : _autosales)
+	else
 	{
-		node["autoSales"].push_back(ruleItem->getName());
+		saveYaml(filepath, mod);
 	}
-	// snapshot of the user options (just for debugging purposes)
+}
+
+/**
+ * Saves a saved game's contents to a binary save.
+ * Each section is serialized and written before the next one is built.
+ * @param filepath Full path of the save.
+ * @param mod Mod for the saved game.
+ */
+void SavedGame::saveBinary(const std::string &filepath, Mod *mod) const
+{
+	BinarySaveWriter writer(filepath, Options::oxceBinarySaveCompression);
+	writer.writeSection(SAVE_SECTION_BRIEF, saveBrief());
+	for (int i = SAVE_SECTION_GEOSCAPE; i < SAVE_SECTION_MAX; ++i)
 	{
-		YAML::Node tmpNode;
-		for (const auto& info : Options::getOptionInfo())
+		YAML::Node node;
+		saveSection((SaveSection)i, node, mod);
+		if (node.size() > 0)
 		{
-			info.save(tmpNode);
+			writer.writeSection((SaveSection)i, node);
 		}
-		node["options"] = tmpNode;
 	}
-	if (_battleGame != 0)
+	writer.finish();
+}
+
+/**
+ * Saves a saved game's contents to a YAML file.
+ * @param filepath Full path of the save.
+ * @param mod Mod for the saved game.
+ */
+void SavedGame::saveYaml(const std::string &filepath, Mod *mod) const
+{
+	SaveSnapshot snap;
+	snapshot(snap, mod);
+	writeSnapshot(snap, filepath, false, 0);
+}
+
+/**
+ * Serializes the whole game into a snapshot that no longer
+ * depends on the game state, so it can be written out later.
+ * @param snap Snapshot to fill.
+ * @param mod Mod for the saved game.
+ */
+void SavedGame::snapshot(SaveSnapshot &snap, Mod *mod) const
+{
+	snap.brief = saveBrief();
+	snap.sections.clear();
+	snap.sections.resize(SAVE_SECTION_MAX);
+	for (int i = SAVE_SECTION_GEOSCAPE; i < SAVE_SECTION_MAX; ++i)
+	{
+		saveSection((SaveSection)i, snap.sections[i], mod);
+	}
+}
+
+/**
+ * Writes a snapshot to a file, either as YAML or as a binary save.
+ * Doesn't touch the game state or log anything, so it's safe
+ * to call from a background thread.
+ * @param snap Snapshot to write.
+ * @param filepath Full path of the save.
+ * @param binary Write a binary save instead of YAML.
+ * @param compression Compression level of binary saves.
+ */
+void SavedGame::writeSnapshot(const SaveSnapshot &snap, const std::string &filepath, bool binary, int compression)
+{
+	if (binary)
 	{
-		node["battleGame"] = _battleGame->save();
+		BinarySaveWriter writer(filepath, compression);
+		writer.writeSection(SAVE_SECTION_BRIEF, snap.brief);
+		for (size_t i = SAVE_SECTION_GEOSCAPE; i < snap.sections.size(); ++i)
+		{
+			if (snap.sections[i].size() > 0)
+			{
+				writer.writeSection((SaveSection)i, snap.sections[i]);
+			}
+		}
+		writer.finish();
+		return;
 	}
-	_scriptValues.save(node, mod->getScriptGlobal());
 
-	out << node;
+	YAML::Emitter out;
 
+	out << snap.brief;
+	// Saves the full game data to the save
+	out << YAML::BeginDoc;
+	emitFullGame(out, snap.sections);
 
-	std::string filepath = Options::getMasterUserFolder() + filename;
-	if (!CrossPlatform::writeFile(filepath, out.c_str()))
+	SDL_RWops *file = SDL_RWFromFile(filepath.c_str(), "w");
+	if (!file)
+	{
+		throw Exception("Failed to save " + filepath);
+	}
+	bool written = SDL_RWwrite(file, out.c_str(), out.size(), 1) == 1;
+	if (SDL_RWclose(file) != 0 || !written)
 	{
 		throw Exception("Failed to save " + filepath);
 	}
@@ -65,6 +65,17 @@ class RuleSoldierTransformation;
 class AlienRace;
 struct MissionStatistics;
 struct BattleUnitKills;
+enum SaveSection : int;
+
+/**
+ * Serialized form of a saved game, detached from the game state
+ * so it can be written out on another thread.
+ */
+struct SaveSnapshot
+{
+	YAML::Node brief;
+	std::vector<YAML::Node> sections;
+};
 
 /**
  * Enumerator containing all the possible game difficulties.
@@ -95,6 +106,20 @@ struct SaveInfo
 	bool reserved;
 };
 
+/**
+ * Save list info decoded from the brief header of a save.
+ * Strings are kept untranslated, so it can be cached in the save index.
+ */
+struct SaveBrief
+{
+	std::string name, mission;
+	bool battle = false;
+	int turn = 0;
+	int day = 1, month = 1, year = 1999, hour = 12, minute = 0;
+	bool ironman = false;
+	std::vector<std::string> mods;
+};
+
 /**
  * The game data that gets written to disk when the game is saved.
  * A saved game holds all the variable info in a game like funds,
@@ -173,7 +198,31 @@ private:
 	bool _alienContainmentChecked;
 	ScriptValues<SavedGame> _scriptValues;
 
-	static SaveInfo getSaveInfo(const std::string &file, Language *lang);
+	/// Cached brief header of a save, valid while the file is unchanged.
+	struct SaveIndexEntry
+	{
+		time_t timestamp = 0;
+		int64_t size = -1;
+		SaveBrief brief;
+	};
+	static const std::string SAVE_INDEX;
+	static const int SAVE_INDEX_VERSION;
+
+	/// Loads the save list index.
+	static std::map<std::string, SaveIndexEntry> loadSaveIndex(const std::string &path);
+	/// Writes the save list index.
+	static void saveSaveIndex(const std::string &path, const std::map<std::string, SaveIndexEntry> &index);
+	/// Reads the brief header of a save file.
+	static SaveBrief getSaveBrief(const std::string &fullname);
+	static SaveInfo getSaveInfo(const std::string &file, const SaveBrief &brief, time_t timestamp, Language *lang);
+	/// Saves the brief game info used in the saves list.
+	YAML::Node saveBrief() const;
+	/// Saves one section of the full game data.
+	void saveSection(SaveSection section, YAML::Node &node, Mod *mod) const;
+	/// Saves a saved game to a YAML file.
+	void saveYaml(const std::string &filepath, Mod *mod) const;
+	/// Saves a saved game to a binary save.
+	void saveBinary(const std::string &filepath, Mod *mod) const;
 public:
 	static const std::string AUTOSAVE_GEOSCAPE, AUTOSAVE_BATTLESCAPE, QUICKSAVE;
 	/// Creates a new saved game.
@@ -184,10 +233,22 @@ public:
 	static std::string sanitizeModName(const std::string &name);
 	/// Gets list of saves in the user directory.
 	static std::vector<SaveInfo> getList(Language *lang, bool autoquick);
+	/// Decodes the brief header of a save.
+	static SaveBrief decodeSaveBrief(const YAML::Node &doc);
+	/// Updates the save list index entry of a save that was just written.
+	static void updateSaveIndex(const std::string &filename, const SaveBrief &brief);
+	/// Updates the save list index entry of this game's save.
+	void updateSaveIndex(const std::string &filename) const;
+	/// Removes a deleted or renamed save from the save list index.
+	static void removeFromSaveIndex(const std::string &filename);
 	/// Loads a saved game from YAML.
 	void load(const std::string &filename, Mod *mod, Language *lang);
-	/// Saves a saved game to YAML.
+	/// Saves a saved game to YAML or a binary save.
 	void save(const std::string &filename, Mod *mod) const;
+	/// Serializes the game into a detached snapshot.
+	void snapshot(SaveSnapshot &snap, Mod *mod) const;
+	/// Writes a snapshot to a file.
+	static void writeSnapshot(const SaveSnapshot &snap, const std::string &filepath, bool binary, int compression);
 	/// Gets the game name.
 	std::string getName() const;
 	/// Sets the game name.
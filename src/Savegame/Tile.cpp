@@ -60,10 +60,6 @@ Tile::Tile(Position pos, SavedBattleGame* save): _save(save), _pos(pos)
 		_mapData->SetID[i] = -1;
 		_objectsCache[i].currentFrame = 0;
 	}
-	for (int layer = 0; layer < LL_MAX; layer++)
-	{
-		_light[layer] = 0;
-	}
 	for (int i = 0; i < O_MAX; ++i)
 	{
 		_objectsCache[i].discovered = 0;
@@ -114,6 +110,7 @@ void Tile::load(const YAML::Node &node)
 	if (_fire || _smoke)
 	{
 		_animationOffset = RNG::seedless(0, 3);
+		trackEnvi();
 	}
 }
 
@@ -145,6 +142,7 @@ void Tile::loadBinary(Uint8 *buffer, Tile::SerializationKey& serKey)
 	if (_fire || _smoke)
 	{
 		_animationOffset = RNG::seedless(0, 3);
+		trackEnvi();
 	}
 }
 
@@ -450,7 +448,7 @@ bool Tile::isDiscovered(TilePart part) const
  */
 void Tile::resetLight(LightLayers layer)
 {
-	_light[layer] = 0;
+	_save->getTileLight(this)[layer] = 0;
 }
 
 /**
@@ -459,9 +457,10 @@ void Tile::resetLight(LightLayers layer)
  */
 void Tile::resetLightMulti(LightLayers layer)
 {
+	auto& levels = _save->getTileLight(this);
 	for (int l = layer; l < LL_MAX; l++)
 	{
-		_light[l] = 0;
+		levels[l] = 0;
 	}
 }
 
@@ -472,8 +471,9 @@ void Tile::resetLightMulti(LightLayers layer)
  */
 void Tile::addLight(int light, LightLayers layer)
 {
-	if (_light[layer] < light)
-		_light[layer] = light;
+	auto& levels = _save->getTileLight(this);
+	if (levels[layer] < light)
+		levels[layer] = light;
 }
 
 /**
@@ -483,17 +483,18 @@ void Tile::addLight(int light, LightLayers layer)
  */
 int Tile::getLight(LightLayers layer) const
 {
-	return _light[layer];
+	return _save->getTileLight(this)[layer];
 }
 
 int Tile::getLightMulti(LightLayers layer) const
 {
+	const auto& levels = _save->getTileLight(this);
 	int light = 0;
 
 	for (int l = layer; l >= 0; --l)
 	{
-		if (_light[l] > light)
-			light = _light[l];
+		if (levels[l] > light)
+			light = levels[l];
 	}
 
 	return light;
@@ -507,12 +508,13 @@ int Tile::getLightMulti(LightLayers layer) const
  */
 int Tile::getShade() const
 {
+	const auto& levels = _save->getTileLight(this);
 	int light = 0;
 
 	for (int layer = 0; layer < LL_MAX; layer++)
 	{
-		if (_light[layer] > light)
-			light = _light[layer];
+		if (levels[layer] > light)
+			light = levels[layer];
 	}
 
 	return std::max(0, 15 - light);
@@ -676,6 +678,7 @@ void Tile::ignite(int power)
 				_overlaps = 1;
 				_fire = getFuel() + 1;
 				_animationOffset = RNG::generate(0,3);
+				trackEnvi();
 			}
 		}
 	}
@@ -755,6 +758,7 @@ void Tile::setFire(int fire)
 {
 	_fire = Clamp(fire, 0, 255);
 	_animationOffset = RNG::generate(0,3);
+	trackEnvi();
 }
 
 /**
@@ -784,6 +788,7 @@ void Tile::addSmoke(int smoke)
 		}
 		_animationOffset = RNG::generate(0,3);
 		addOverlap();
+		trackEnvi();
 	}
 }
 
@@ -795,6 +800,28 @@ void Tile::setSmoke(int smoke)
 {
 	_smoke = Clamp(smoke, 0, 255);
 	_animationOffset = RNG::generate(0,3);
+	trackEnvi();
+}
+
+/**
+ * Adds this tile to the battle's list of tiles with fire or smoke,
+ * the list is pruned of tiles that stopped burning or smoking at the start of each turn.
+ */
+void Tile::trackEnvi()
+{
+	if ((_fire || _smoke) && !_cache.enviTracked)
+	{
+		_cache.enviTracked = 1;
+		_save->addEnviTile(this);
+	}
+}
+
+/**
+ * Clears the flag set when tile was added to the battle's list of tiles with fire or smoke.
+ */
+void Tile::untrackEnvi()
+{
+	_cache.enviTracked = 0;
 }
 
 
@@ -1060,6 +1087,10 @@ void Tile::addOverlap()
  */
 void Tile::setDangerous(bool danger)
 {
+	if (danger && !_cache.danger)
+	{
+		_save->addDangerousTile(this);
+	}
 	_cache.danger = danger;
 }
 
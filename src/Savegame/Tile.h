@@ -17,6 +17,7 @@
  * You should have received a copy of the GNU General Public License
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <array>
 #include <vector>
 #include <memory>
 #include "../Engine/Surface.h"
@@ -37,6 +38,9 @@ class ScriptParserBase;
 
 enum LightLayers : Uint8 { LL_AMBIENT, LL_FIRE, LL_ITEMS, LL_UNITS, LL_MAX };
 
+/// Light levels of one tile, one value per layer.
+using TileLight = std::array<Uint8, LL_MAX>;
+
 enum TileUnitOverlapping : int
 {
 	/// Any unit overlapping tile will be returned
@@ -105,6 +109,7 @@ public:
 		Uint8 isLadder:1;
 		Uint8 bigWall:1;
 		Uint8 danger:1;
+		Uint8 enviTracked:1;
 	};
 
 protected:
@@ -117,7 +122,6 @@ protected:
 	TileObjectCache _objectsCache[O_MAX] = { };
 	TileCache _cache = { };
 	Position _pos;
-	Uint8 _light[LL_MAX];
 	Uint8 _fire = 0;
 	Uint8 _smoke = 0;
 	Uint8 _markerColor = 0;
@@ -131,6 +135,8 @@ protected:
 	Sint8 _preview = -1;
 	Uint8 _overlaps = 0;
 
+	/// Registers tile with fire or smoke in the battle's list of such tiles.
+	void trackEnvi();
 
 public:
 	/// Creates a tile.
@@ -393,6 +399,8 @@ public:
 	int getOverlaps() const;
 	/// increment the overlap value on this tile.
 	void addOverlap();
+	/// Clear the flag of being in the battle's list of tiles with fire or smoke.
+	void untrackEnvi();
 	/// set the danger flag on this tile (so the AI will avoid it).
 	void setDangerous(bool danger);
 	/// check the danger flag on this tile.
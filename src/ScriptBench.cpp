@@ -0,0 +1,246 @@
+/*
+ * Copyright 2010-2023 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <SDL.h>
+#include "Engine/Exception.h"
+#include "Engine/Logger.h"
+#include "Engine/Options.h"
+#include "Engine/Script.h"
+
+/**
+ * Micro-benchmark of mod script execution, built with BUILD_SCRIPT_BENCH.
+ *
+ * Compiles scripts shaped like the default recolor and select sprite scripts
+ * and some common mod patterns, then runs each of them for every pixel of
+ * a batch of sprites. Every script is compiled twice, with and without
+ * the fusing of operation pairs, to show what it gains and to check
+ * that both versions return the same values.
+ *
+ * Usage: openxcom_script_bench [iterations]
+ */
+
+using namespace OpenXcom;
+
+namespace
+{
+
+/// Same arguments as the recolor scripts, without the object pointers.
+using RecolorParser = ScriptParser<ScriptOutputArgs<int&, int>, int, int, int, int>;
+/// Same arguments as the select sprite scripts, without the object pointers.
+using SelectParser = ScriptParser<ScriptOutputArgs<int&, int>, int, int, int>;
+
+const int SpriteSize = 32 * 40;
+const int SpriteFrames = 8;
+const int BenchRepeats = 5;
+
+struct BenchScript
+{
+	const char *name;
+	const char *code;
+};
+
+const BenchScript RecolorScripts[] =
+{
+	{
+		"recolor default",
+		"add_shade new_pixel shade; return new_pixel;"
+	},
+	{
+		"recolor color swap",
+		"var int color;"
+		"get_color color new_pixel;"
+		"if eq color 4; set_color new_pixel 2; end;"
+		"add_shade new_pixel shade;"
+		"return new_pixel;"
+	},
+	{
+		"recolor glow",
+		"var int color; var int temp;"
+		"get_color color new_pixel;"
+		"if eq color 8;"
+		"  set temp anim_frame; mod temp 16; add temp shade; limit temp 0 15;"
+		"  set_shade new_pixel temp;"
+		"else;"
+		"  add_shade new_pixel shade;"
+		"end;"
+		"return new_pixel;"
+	},
+	{
+		"recolor dark parts",
+		"var int temp;"
+		"get_shade temp new_pixel;"
+		"if le temp 3; return new_pixel; end;"
+		"if eq blit_part 2; add temp burn; limit temp 0 15; set_shade new_pixel temp; end;"
+		"add_shade new_pixel shade;"
+		"return new_pixel;"
+	},
+};
+
+const BenchScript SelectScripts[] =
+{
+	{
+		"select default",
+		"add sprite_index sprite_offset; return sprite_index;"
+	},
+	{
+		"select animated",
+		"var int temp;"
+		"set temp anim_frame; mod temp 4;"
+		"if eq blit_part 0; add sprite_index temp; end;"
+		"add sprite_index sprite_offset;"
+		"return sprite_index;"
+	},
+};
+
+/**
+ * Result of running one compiled script.
+ */
+struct BenchResult
+{
+	double nanoseconds;
+	Uint64 checksum;
+};
+
+/**
+ * Runs a recolor script for every pixel of every sprite frame.
+ */
+BenchResult runRecolor(const RecolorParser::Container &script, int iterations)
+{
+	BenchResult result = { 0.0, 0 };
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i)
+	{
+		for (int frame = 0; frame < SpriteFrames; ++frame)
+		{
+			RecolorParser::Worker worker{ frame % 4, frame, i % 8, frame };
+			for (int p = 0; p < SpriteSize; ++p)
+			{
+				const int pixel = (p * 7 + frame) & 0xFF;
+				RecolorParser::Output arg{ pixel, pixel };
+				worker.execute(script, arg);
+				result.checksum = result.checksum * 31 + (Uint64)arg.getFirst();
+			}
+		}
+	}
+	const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+	result.nanoseconds = (double)time.count() / ((double)iterations * SpriteFrames * SpriteSize);
+	return result;
+}
+
+/**
+ * Runs a select sprite script for every body part of every sprite frame.
+ */
+BenchResult runSelect(const SelectParser::Container &script, int iterations)
+{
+	const int calls = SpriteSize / 8;
+	BenchResult result = { 0.0, 0 };
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i)
+	{
+		for (int frame = 0; frame < SpriteFrames; ++frame)
+		{
+			for (int c = 0; c < calls; ++c)
+			{
+				SelectParser::Worker worker{ c % 8, frame, i % 8 };
+				SelectParser::Output arg{ c, frame * 8 };
+				worker.execute(script, arg);
+				result.checksum = result.checksum * 31 + (Uint64)arg.getFirst();
+			}
+		}
+	}
+	const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+	result.nanoseconds = (double)time.count() / ((double)iterations * SpriteFrames * calls);
+	return result;
+}
+
+/**
+ * Compiles a script with and without fused operations, runs both and prints the times.
+ * @return True if both versions gave the same results.
+ */
+template<typename Parser, typename Run>
+bool benchScript(const Parser &parser, const BenchScript &bench, int iterations, Run run)
+{
+	typename Parser::Container plain, fused;
+	Options::oxceScriptOptimize = false;
+	plain.load(bench.name, std::string(bench.code), parser);
+	Options::oxceScriptOptimize = true;
+	fused.load(bench.name, std::string(bench.code), parser);
+	if (!plain || !fused)
+	{
+		throw Exception(std::string("Failed to compile script: ") + bench.name);
+	}
+
+	// best of few alternating runs, to filter out noise from the rest of the system
+	BenchResult plainResult = run(plain, iterations);
+	BenchResult fusedResult = run(fused, iterations);
+	for (int i = 1; i < BenchRepeats; ++i)
+	{
+		plainResult.nanoseconds = std::min(plainResult.nanoseconds, run(plain, iterations).nanoseconds);
+		fusedResult.nanoseconds = std::min(fusedResult.nanoseconds, run(fused, iterations).nanoseconds);
+	}
+	std::cout << std::left << std::setw(24) << bench.name << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << plainResult.nanoseconds
+		<< std::setw(10) << fusedResult.nanoseconds
+		<< std::setw(9) << (100.0 * (plainResult.nanoseconds - fusedResult.nanoseconds) / plainResult.nanoseconds) << "%"
+		<< std::endl;
+	if (plainResult.checksum != fusedResult.checksum)
+	{
+		std::cout << "  results differ between plain and fused script!" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	const int iterations = argc > 1 ? std::max(1, atoi(argv[1])) : 200;
+	// there is no log file, messages like script errors are only printed to stderr at debug level
+	Logger::reportingLevel() = LOG_DEBUG;
+
+	bool valid = true;
+	try
+	{
+		ScriptGlobal global;
+		RecolorParser recolor{ &global, "benchRecolor", "new_pixel", "old_pixel", "blit_part", "anim_frame", "shade", "burn" };
+		SelectParser select{ &global, "benchSelect", "sprite_index", "sprite_offset", "blit_part", "anim_frame", "shade" };
+
+		std::cout << "script                   plain ns  fused ns     gain" << std::endl;
+		for (const auto &bench : RecolorScripts)
+		{
+			valid &= benchScript(recolor, bench, iterations, runRecolor);
+		}
+		for (const auto &bench : SelectScripts)
+		{
+			valid &= benchScript(select, bench, iterations, runSelect);
+		}
+	}
+	catch (Exception &e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -45,7 +45,7 @@ namespace OpenXcom
 		_txtTitle = new Text(300, 17, 5, 24);
 
 		// Set palette
-		Surface* customArmorSprite = defs->image_id.empty() ? nullptr : _game->getMod()->getSurface(defs->image_id, true);
+		Surface* customArmorSprite = defs->image_id.empty() ? nullptr : _game->getMod()->getTransientSurface(defs->image_id, true);
 		if (defs->customPalette && customArmorSprite)
 		{
 			setCustomPalette(customArmorSprite->getPalette(), Mod::BATTLESCAPE_CURSOR);
@@ -92,7 +92,7 @@ namespace OpenXcom
 
 			for (const auto& layer : s->getArmorLayers())
 			{
-				auto* surf = _game->getMod()->getSurface(layer, true);
+				auto* surf = _game->getMod()->getTransientSurface(layer, true);
 				surf->blitNShade(_bg, 0, 0);
 			}
 			delete s;
@@ -102,15 +102,15 @@ namespace OpenXcom
 		{
 			std::string look = armor->getSpriteInventory();
 			look += "M0.SPK";
-			if (!_game->getMod()->getSurface(look, false))
+			if (!_game->getMod()->getTransientSurface(look, false))
 			{
 				look = armor->getSpriteInventory() + ".SPK";
 			}
-			if (!_game->getMod()->getSurface(look, false))
+			if (!_game->getMod()->getTransientSurface(look, false))
 			{
 				look = armor->getSpriteInventory();
 			}
-			_game->getMod()->getSurface(look, true)->blitNShade(_bg, 0, 0);
+			_game->getMod()->getTransientSurface(look, true)->blitNShade(_bg, 0, 0);
 		}
 
 
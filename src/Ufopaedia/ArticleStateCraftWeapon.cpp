@@ -59,7 +59,7 @@ namespace OpenXcom
 		// Set palette
 		if (defs->customPalette)
 		{
-			setCustomPalette(_game->getMod()->getSurface(defs->image_id)->getPalette(), Mod::BATTLESCAPE_CURSOR);
+			setCustomPalette(_game->getMod()->getTransientSurface(defs->image_id)->getPalette(), Mod::BATTLESCAPE_CURSOR);
 		}
 		else
 		{
@@ -78,7 +78,7 @@ namespace OpenXcom
 		add(_txtTitle);
 
 		// Set up objects
-		_game->getMod()->getSurface(defs->image_id)->blitNShade(_bg, 0, 0);
+		_game->getMod()->getTransientSurface(defs->image_id)->blitNShade(_bg, 0, 0);
 		_btnOk->setColor(_buttonColor);
 		_btnPrev->setColor(_buttonColor);
 		_btnNext->setColor(_buttonColor);
@@ -77,7 +77,7 @@ namespace OpenXcom
 			else
 				_cursorColor = Mod::BATTLESCAPE_CURSOR;
 
-			setCustomPalette(_game->getMod()->getSurface(defs->image_id)->getPalette(), _cursorColor);
+			setCustomPalette(_game->getMod()->getTransientSurface(defs->image_id)->getPalette(), _cursorColor);
 		}
 		else
 		{
@@ -125,18 +125,18 @@ namespace OpenXcom
 		// Step 1: background image
 		if (!defs->customPalette)
 		{
-			_game->getMod()->getSurface(ruleInterface->getBackgroundImage())->blitNShade(_bg, 0, 0);
+			_game->getMod()->getTransientSurface(ruleInterface->getBackgroundImage())->blitNShade(_bg, 0, 0);
 		}
 
 		// Step 2: article image (optional)
-		Surface *image = _game->getMod()->getSurface(defs->image_id, false);
+		Surface *image = _game->getMod()->getTransientSurface(defs->image_id, false);
 		if (image)
 		{
 			image->blitNShade(_bg, 0, 0);
 		}
 
 		// Step 3: info button image
-		Surface *button = _game->getMod()->getSurface(ruleInterface->getBackgroundImage() + "-InfoButton", false);
+		Surface *button = _game->getMod()->getTransientSurface(ruleInterface->getBackgroundImage() + "-InfoButton", false);
 		if (!defs->customPalette && button && _game->getMod()->getShowPediaInfoButton())
 		{
 			switch (defs->getType())
@@ -52,7 +52,7 @@ namespace OpenXcom
 		centerAllSurfaces();
 
 		// Set up objects
-		_game->getMod()->getSurface("BACK10.SCR")->blitNShade(_bg, 0, 0);
+		_game->getMod()->getTransientSurface("BACK10.SCR")->blitNShade(_bg, 0, 0);
 		_btnOk->setColor(_buttonColor);
 		_btnPrev->setColor(_buttonColor);
 		_btnNext->setColor(_buttonColor);
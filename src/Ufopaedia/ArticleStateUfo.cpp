@@ -50,7 +50,7 @@ namespace OpenXcom
 		add(_txtTitle);
 
 		// Set up objects
-		_game->getMod()->getSurface("BACK11.SCR")->blitNShade(_bg, 0, 0);
+		_game->getMod()->getTransientSurface("BACK11.SCR")->blitNShade(_bg, 0, 0);
 		_btnOk->setColor(Palette::blockOffset(8)+5);
 		_btnPrev->setColor(Palette::blockOffset(8)+5);
 		_btnNext->setColor(Palette::blockOffset(8)+5);
@@ -67,7 +67,7 @@ namespace OpenXcom
 
 		RuleInterface *dogfightInterface = _game->getMod()->getInterface("dogfight");
 
-		SurfaceCrop crop = _game->getMod()->getSurface("INTERWIN.DAT")->getCrop();
+		SurfaceCrop crop = _game->getMod()->getTransientSurface("INTERWIN.DAT")->getCrop();
 		crop.setX(0);
 		crop.setY(0);
 		crop.getCrop()->x = 0;
@@ -84,7 +84,7 @@ namespace OpenXcom
 		}
 		else
 		{
-			crop = _game->getMod()->getSurface(ufo->getModSprite())->getCrop();
+			crop = _game->getMod()->getTransientSurface(ufo->getModSprite())->getCrop();
 		}
 		crop.setX(0);
 		crop.setY(0);